@@ -92,6 +92,16 @@ workspace "kmeter"
 
     cppdialect "C++14"
 
+    -- default skin compiled into C++ code by "kmeter_skinc_* --embed",
+    -- so that the plug-ins also run without their skin directory
+    files {
+        "../Source/generated/default_skin.cpp"
+    }
+
+    defines {
+        "KMETER_EMBEDDED_SKIN=1"
+    }
+
     filter { "system:linux", "platforms:x32" }
         linkoptions {
             -- force static linking to FFTW
@@ -243,6 +253,16 @@ workspace "kmeter"
               "../JuceLibraryCode/include_juce_audio_plugin_client_Standalone.cpp"
         }
 
+    -- default skin compiled into C++ code by "kmeter_skinc_* --embed",
+    -- so that the plug-ins also run without their skin directory
+    files {
+        "../Source/generated/default_skin.cpp"
+    }
+
+    defines {
+        "KMETER_EMBEDDED_SKIN=1"
+    }
+
     filter { "system:linux", "platforms:x32" }
         linkoptions {
             -- force static linking to FFTW
@@ -305,6 +325,16 @@ workspace "kmeter"
               "../JuceLibraryCode/include_juce_audio_plugin_client_Standalone.cpp"
         }
 
+    -- default skin compiled into C++ code by "kmeter_skinc_* --embed",
+    -- so that the plug-ins also run without their skin directory
+    files {
+        "../Source/generated/default_skin.cpp"
+    }
+
+    defines {
+        "KMETER_EMBEDDED_SKIN=1"
+    }
+
     filter { "system:linux", "platforms:x32" }
         linkoptions {
             -- force static linking to FFTW
@@ -376,6 +406,16 @@ workspace "kmeter"
             "../libraries/vst2/VST2_SDK"
         }
 
+    -- default skin compiled into C++ code by "kmeter_skinc_* --embed",
+    -- so that the plug-ins also run without their skin directory
+    files {
+        "../Source/generated/default_skin.cpp"
+    }
+
+    defines {
+        "KMETER_EMBEDDED_SKIN=1"
+    }
+
     filter { "system:linux", "platforms:x32" }
         linkoptions {
             -- force static linking to FFTW
@@ -437,6 +477,16 @@ workspace "kmeter"
             "../libraries/vst2/VST2_SDK"
         }
 
+    -- default skin compiled into C++ code by "kmeter_skinc_* --embed",
+    -- so that the plug-ins also run without their skin directory
+    files {
+        "../Source/generated/default_skin.cpp"
+    }
+
+    defines {
+        "KMETER_EMBEDDED_SKIN=1"
+    }
+
     filter { "system:linux", "platforms:x32" }
         linkoptions {
             -- force static linking to FFTW
@@ -502,6 +552,16 @@ if os.target() == "windows" then
             "../libraries/vst3/VST3_SDK"
         }
 
+    -- default skin compiled into C++ code by "kmeter_skinc_* --embed",
+    -- so that the plug-ins also run without their skin directory
+    files {
+        "../Source/generated/default_skin.cpp"
+    }
+
+    defines {
+        "KMETER_EMBEDDED_SKIN=1"
+    }
+
     filter { "system:linux", "platforms:x32" }
         linkoptions {
             -- force static linking to FFTW
@@ -567,6 +627,16 @@ if os.target() == "windows" then
             "../libraries/vst3/VST3_SDK"
         }
 
+    -- default skin compiled into C++ code by "kmeter_skinc_* --embed",
+    -- so that the plug-ins also run without their skin directory
+    files {
+        "../Source/generated/default_skin.cpp"
+    }
+
+    defines {
+        "KMETER_EMBEDDED_SKIN=1"
+    }
+
     filter { "system:linux", "platforms:x32" }
         linkoptions {
             -- force static linking to FFTW
@@ -599,3 +669,371 @@ if os.target() == "windows" then
 
 -- create VST3 projects on Windows only
 end
+
+--------------------------------------------------------------------------------
+
+    project ("kmeter_bench_stereo")
+        kind "ConsoleApp"
+        targetdir "../bin/bench/"
+
+        defines {
+            "KMETER_STEREO=1",
+            "JucePlugin_Build_Standalone=1",
+            "JucePlugin_Build_VST=0",
+            "JucePlugin_Build_VST3=0"
+        }
+
+        files {
+            "../Source/bench/*.h",
+            "../Source/bench/*.cpp"
+        }
+
+        defines {
+            "JUCE_ALSA=0",
+            "JUCE_JACK=0",
+            "JUCE_WASAPI=0",
+            "JUCE_DIRECTSOUND=0"
+        }
+
+    -- default skin compiled into C++ code by "kmeter_skinc_* --embed",
+    -- so that the plug-ins also run without their skin directory
+    files {
+        "../Source/generated/default_skin.cpp"
+    }
+
+    defines {
+        "KMETER_EMBEDDED_SKIN=1"
+    }
+
+    filter { "system:linux", "platforms:x32" }
+        linkoptions {
+            -- force static linking to FFTW
+            "../../../libraries/fftw/bin/linux/i386/libfftw3f.a"
+        }
+
+    filter { "system:linux", "platforms:x64" }
+        linkoptions {
+            -- force static linking to FFTW
+            "../../../libraries/fftw/bin/linux/amd64/libfftw3f.a"
+        }
+
+        filter { "system:linux" }
+            targetname "kmeter_bench_stereo"
+
+        filter { "system:windows" }
+            targetname "K-Meter Benchmark (Stereo"
+            targetextension (".exe")
+
+        filter { "configurations:Debug" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/bench_stereo_debug")
+
+        filter { "configurations:Release" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/bench_stereo_release")
+
+--------------------------------------------------------------------------------
+
+    project ("kmeter_bench_surround")
+        kind "ConsoleApp"
+        targetdir "../bin/bench/"
+
+        defines {
+            "KMETER_SURROUND=1",
+            "JucePlugin_Build_Standalone=1",
+            "JucePlugin_Build_VST=0",
+            "JucePlugin_Build_VST3=0"
+        }
+
+        files {
+            "../Source/bench/*.h",
+            "../Source/bench/*.cpp"
+        }
+
+        defines {
+            "JUCE_ALSA=0",
+            "JUCE_JACK=0",
+            "JUCE_WASAPI=0",
+            "JUCE_DIRECTSOUND=0"
+        }
+
+    -- default skin compiled into C++ code by "kmeter_skinc_* --embed",
+    -- so that the plug-ins also run without their skin directory
+    files {
+        "../Source/generated/default_skin.cpp"
+    }
+
+    defines {
+        "KMETER_EMBEDDED_SKIN=1"
+    }
+
+    filter { "system:linux", "platforms:x32" }
+        linkoptions {
+            -- force static linking to FFTW
+            "../../../libraries/fftw/bin/linux/i386/libfftw3f.a"
+        }
+
+    filter { "system:linux", "platforms:x64" }
+        linkoptions {
+            -- force static linking to FFTW
+            "../../../libraries/fftw/bin/linux/amd64/libfftw3f.a"
+        }
+
+        filter { "system:linux" }
+            targetname "kmeter_bench_surround"
+
+        filter { "system:windows" }
+            targetname "K-Meter Benchmark (Surround"
+            targetextension (".exe")
+
+        filter { "configurations:Debug" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/bench_surround_debug")
+
+        filter { "configurations:Release" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/bench_surround_release")
+
+--------------------------------------------------------------------------------
+
+    project ("kmeter_test_stereo")
+        kind "ConsoleApp"
+        targetdir "../bin/test/"
+
+        defines {
+            "KMETER_STEREO=1",
+            "JucePlugin_Build_Standalone=1",
+            "JucePlugin_Build_VST=0",
+            "JucePlugin_Build_VST3=0"
+        }
+
+        files {
+            "../Source/test/*.h",
+            "../Source/test/*.cpp"
+        }
+
+        defines {
+            "JUCE_ALSA=0",
+            "JUCE_JACK=0",
+            "JUCE_WASAPI=0",
+            "JUCE_DIRECTSOUND=0"
+        }
+
+    -- default skin compiled into C++ code by "kmeter_skinc_* --embed",
+    -- so that the plug-ins also run without their skin directory
+    files {
+        "../Source/generated/default_skin.cpp"
+    }
+
+    defines {
+        "KMETER_EMBEDDED_SKIN=1"
+    }
+
+    filter { "system:linux", "platforms:x32" }
+        linkoptions {
+            -- force static linking to FFTW
+            "../../../libraries/fftw/bin/linux/i386/libfftw3f.a"
+        }
+
+    filter { "system:linux", "platforms:x64" }
+        linkoptions {
+            -- force static linking to FFTW
+            "../../../libraries/fftw/bin/linux/amd64/libfftw3f.a"
+        }
+
+        filter { "system:linux" }
+            targetname "kmeter_test_stereo"
+
+            linkoptions {
+                -- export symbols for readable backtraces
+                "-rdynamic"
+            }
+
+        filter { "system:windows" }
+            targetname "K-Meter Tests (Stereo"
+            targetextension (".exe")
+
+        filter { "configurations:Debug" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/test_stereo_debug")
+
+        filter { "configurations:Release" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/test_stereo_release")
+
+--------------------------------------------------------------------------------
+
+    project ("kmeter_test_surround")
+        kind "ConsoleApp"
+        targetdir "../bin/test/"
+
+        defines {
+            "KMETER_SURROUND=1",
+            "JucePlugin_Build_Standalone=1",
+            "JucePlugin_Build_VST=0",
+            "JucePlugin_Build_VST3=0"
+        }
+
+        files {
+            "../Source/test/*.h",
+            "../Source/test/*.cpp"
+        }
+
+        defines {
+            "JUCE_ALSA=0",
+            "JUCE_JACK=0",
+            "JUCE_WASAPI=0",
+            "JUCE_DIRECTSOUND=0"
+        }
+
+    -- default skin compiled into C++ code by "kmeter_skinc_* --embed",
+    -- so that the plug-ins also run without their skin directory
+    files {
+        "../Source/generated/default_skin.cpp"
+    }
+
+    defines {
+        "KMETER_EMBEDDED_SKIN=1"
+    }
+
+    filter { "system:linux", "platforms:x32" }
+        linkoptions {
+            -- force static linking to FFTW
+            "../../../libraries/fftw/bin/linux/i386/libfftw3f.a"
+        }
+
+    filter { "system:linux", "platforms:x64" }
+        linkoptions {
+            -- force static linking to FFTW
+            "../../../libraries/fftw/bin/linux/amd64/libfftw3f.a"
+        }
+
+        filter { "system:linux" }
+            targetname "kmeter_test_surround"
+
+            linkoptions {
+                -- export symbols for readable backtraces
+                "-rdynamic"
+            }
+
+        filter { "system:windows" }
+            targetname "K-Meter Tests (Surround"
+            targetextension (".exe")
+
+        filter { "configurations:Debug" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/test_surround_debug")
+
+        filter { "configurations:Release" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/test_surround_release")
+
+--------------------------------------------------------------------------------
+
+    project ("kmeter_skinc_stereo")
+        kind "ConsoleApp"
+        targetdir "../bin/skinc/"
+
+        defines {
+            "KMETER_STEREO=1",
+            "JucePlugin_Build_Standalone=1",
+            "JucePlugin_Build_VST=0",
+            "JucePlugin_Build_VST3=0"
+        }
+
+        files {
+            "../Source/tools/*.cpp"
+        }
+
+        defines {
+            "JUCE_ALSA=0",
+            "JUCE_JACK=0",
+            "JUCE_WASAPI=0",
+            "JUCE_DIRECTSOUND=0"
+        }
+
+    -- default skin compiled into C++ code by "kmeter_skinc_* --embed",
+    -- so that the plug-ins also run without their skin directory
+    files {
+        "../Source/generated/default_skin.cpp"
+    }
+
+    defines {
+        "KMETER_EMBEDDED_SKIN=1"
+    }
+
+    filter { "system:linux", "platforms:x32" }
+        linkoptions {
+            -- force static linking to FFTW
+            "../../../libraries/fftw/bin/linux/i386/libfftw3f.a"
+        }
+
+    filter { "system:linux", "platforms:x64" }
+        linkoptions {
+            -- force static linking to FFTW
+            "../../../libraries/fftw/bin/linux/amd64/libfftw3f.a"
+        }
+
+        filter { "system:linux" }
+            targetname "kmeter_skinc_stereo"
+
+        filter { "system:windows" }
+            targetname "K-Meter Skin Compiler (Stereo"
+            targetextension (".exe")
+
+        filter { "configurations:Debug" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/skinc_stereo_debug")
+
+        filter { "configurations:Release" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/skinc_stereo_release")
+
+--------------------------------------------------------------------------------
+
+    project ("kmeter_skinc_surround")
+        kind "ConsoleApp"
+        targetdir "../bin/skinc/"
+
+        defines {
+            "KMETER_SURROUND=1",
+            "JucePlugin_Build_Standalone=1",
+            "JucePlugin_Build_VST=0",
+            "JucePlugin_Build_VST3=0"
+        }
+
+        files {
+            "../Source/tools/*.cpp"
+        }
+
+        defines {
+            "JUCE_ALSA=0",
+            "JUCE_JACK=0",
+            "JUCE_WASAPI=0",
+            "JUCE_DIRECTSOUND=0"
+        }
+
+    -- default skin compiled into C++ code by "kmeter_skinc_* --embed",
+    -- so that the plug-ins also run without their skin directory
+    files {
+        "../Source/generated/default_skin.cpp"
+    }
+
+    defines {
+        "KMETER_EMBEDDED_SKIN=1"
+    }
+
+    filter { "system:linux", "platforms:x32" }
+        linkoptions {
+            -- force static linking to FFTW
+            "../../../libraries/fftw/bin/linux/i386/libfftw3f.a"
+        }
+
+    filter { "system:linux", "platforms:x64" }
+        linkoptions {
+            -- force static linking to FFTW
+            "../../../libraries/fftw/bin/linux/amd64/libfftw3f.a"
+        }
+
+        filter { "system:linux" }
+            targetname "kmeter_skinc_surround"
+
+        filter { "system:windows" }
+            targetname "K-Meter Skin Compiler (Surround"
+            targetextension (".exe")
+
+        filter { "configurations:Debug" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/skinc_surround_debug")
+
+        filter { "configurations:Release" }
+            objdir ("../bin/.intermediate_" .. os.target() .. "/skinc_surround_release")
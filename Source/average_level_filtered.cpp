@@ -27,37 +27,41 @@
 
 
 AverageLevelFiltered::AverageLevelFiltered(
-    const int numberOfChannels,
+    const AudioChannelSet &channelSet,
     const double sampleRate,
     const int fftBufferSize,
     const int averageAlgorithm) :
 
-    frut::dsp::FIRFilterBox(numberOfChannels, fftBufferSize),
+    frut::dsp::FIRFilterBox(channelSet.size(), fftBufferSize),
     sampleRate_(sampleRate),
-    previousSamplesPreFilterInput_(
-        numberOfChannels_, KMETER_MAXIMUM_FILTER_STAGES - 1),
-    previousSamplesPreFilterOutput_(
-        numberOfChannels_, KMETER_MAXIMUM_FILTER_STAGES - 1),
-    previousSamplesWeightingFilterInput_(
-        numberOfChannels_, KMETER_MAXIMUM_FILTER_STAGES - 1),
-    previousSamplesWeightingFilterOutput_(
-        numberOfChannels_, KMETER_MAXIMUM_FILTER_STAGES - 1),
-    previousSamplesOutputTemp_(1, fftBufferSize_)
+    weightedSampleBuffer_(numberOfChannels_, fftBufferSize_),
+    weightingFilters_(numberOfChannels_, 2, fftBufferSize_),
+    averageAlgorithm_(-1),
+    useExactConversion_(false)
 {
-    dither_.initialise(numberOfChannels_, 24);
-
-    peakToAverageCorrection_ = 0.0f;
-    averageAlgorithm_ = -1;
-
     float meterMinimumDecibel = MeterBallistics::getMeterMinimumDecibel();
 
+    for (int algorithm = 0;
+            algorithm < KmeterPluginParameters::nNumAlgorithms;
+            ++algorithm)
+    {
+        for (int channel = 0; channel < numberOfChannels_; ++channel)
+        {
+            loudnessValues_[algorithm].add(meterMinimumDecibel);
+        }
+    }
+
     for (int channel = 0; channel < numberOfChannels_; ++channel)
     {
-        loudnessValues_.add(meterMinimumDecibel);
+        channelWeights_.add(getChannelWeight(channelSet, channel));
     }
 
-    // also calculates filter kernel
+    // the filters of all algorithms are calculated up front, so
+    // changing the algorithm later on is instant
+    calculateFilterKernel();
+
     setAlgorithm(averageAlgorithm);
+    currentAlgorithm_ = averageAlgorithm_.load();
 }
 
 
@@ -71,98 +75,71 @@ void AverageLevelFiltered::reset()
     FIRFilterBox::reset();
 
     float meterMinimumDecibel = MeterBallistics::getMeterMinimumDecibel();
-    loudnessValues_.fill(meterMinimumDecibel);
 
-    previousSamplesPreFilterInput_.clear();
-    previousSamplesPreFilterOutput_.clear();
+    for (int algorithm = 0;
+            algorithm < KmeterPluginParameters::nNumAlgorithms;
+            ++algorithm)
+    {
+        loudnessValues_[algorithm].fill(meterMinimumDecibel);
+    }
 
-    previousSamplesWeightingFilterInput_.clear();
-    previousSamplesWeightingFilterOutput_.clear();
+    weightedSampleBuffer_.clear();
 
-    previousSamplesOutputTemp_.clear();
+    weightingFilters_.resetDelays();
 }
 
 
 int AverageLevelFiltered::getAlgorithm() const
 {
-    return averageAlgorithm_;
+    return averageAlgorithm_.load();
 }
 
 
+// may be called from any thread; the new algorithm is applied at the
+// start of the next chunk
 void AverageLevelFiltered::setAlgorithm(
     const int averageAlgorithm)
 {
-    if (averageAlgorithm == averageAlgorithm_)
+    if (averageAlgorithm == averageAlgorithm_.load())
     {
         return;
     }
 
-    DBG(String("[K-Meter] averaging algorithm: ") +
-        (averageAlgorithm == KmeterPluginParameters::selAlgorithmItuBs1770 ?
-         "ITU-R BS.1770-1" : "RMS"));
-
     if ((averageAlgorithm >= 0) &&
             (averageAlgorithm < KmeterPluginParameters::nNumAlgorithms))
     {
-        averageAlgorithm_ = averageAlgorithm;
+        averageAlgorithm_.store(averageAlgorithm);
     }
     else
     {
-        averageAlgorithm_ = KmeterPluginParameters::selAlgorithmItuBs1770;
+        averageAlgorithm_.store(KmeterPluginParameters::selAlgorithmItuBs1770);
     }
-
-    calculateFilterKernel();
 }
 
 
-void AverageLevelFiltered::calculateFilterKernel()
+// select exact (validation) or fast conversion of levels to
+// decibels
+void AverageLevelFiltered::setExactConversion(
+    const bool useExactConversion)
 {
-    // reset IIR coefficients and previous samples
-    preFilterInputCoefficients_.clear();
-    preFilterOutputCoefficients_.clear();
-
-    weightingFilterInputCoefficients_.clear();
-    weightingFilterOutputCoefficients_.clear();
-
-    for (int stage = 0; stage < KMETER_MAXIMUM_FILTER_STAGES; ++stage)
-    {
-        preFilterInputCoefficients_.add(0.0);
-        preFilterOutputCoefficients_.add(0.0);
-
-        weightingFilterInputCoefficients_.add(0.0);
-        weightingFilterOutputCoefficients_.add(0.0);
-    }
+    useExactConversion_ = useExactConversion;
+}
 
-    previousSamplesPreFilterInput_.clear();
-    previousSamplesPreFilterOutput_.clear();
 
-    previousSamplesWeightingFilterInput_.clear();
-    previousSamplesWeightingFilterOutput_.clear();
+void AverageLevelFiltered::calculateFilterKernel()
+{
+    // reset previous samples of IIR filters
+    weightingFilters_.resetDelays();
 
     // make sure there's no overlap yet
     fftSampleBuffer_.clear();
     fftOverlapAddSamples_.clear();
 
-    // set peak-to-average gain correction, the gain to add to average
-    // levels so that sine waves read the same on peak and average
-    // meters
-    if (averageAlgorithm_ == KmeterPluginParameters::selAlgorithmItuBs1770)
-    {
-        calculateFilterKernel_ItuBs1770();
-
-        // ITU-R BS.1770-1 provides its own peak-to-average gain
-        // correction, so we don't need to apply any!
-        peakToAverageCorrection_ = 0.0f;
-    }
-    else
-    {
-        calculateFilterKernel_Rms();
-
-        // RMS peak-to-average gain correction; this is simply the
-        // level difference between the peak and RMS level of a sine
-        // wave: RMS / A = sqrt(2) = +3.0103 dB
-        peakToAverageCorrection_ = +3.0103f;
-    }
+    // both algorithms share the low-pass filter; as all filters are
+    // linear, ITU-R BS.1770-1 can apply its weighting filters to the
+    // output of the low-pass filter
+    calculateFilterKernel_Rms();
+    calculateFilterKernel_ItuBs1770();
 }
 
 
@@ -197,13 +174,13 @@ void AverageLevelFiltered::calculateFilterKernel_ItuBs1770()
     double pf_omega_q = pf_omega / pf_q;
     double pf_div = (pf_omega_2 + pf_omega_q + 1.0);
 
-    preFilterInputCoefficients_.set(0, (pf_vl * pf_omega_2 + pf_vb * pf_omega_q + pf_vh) / pf_div);
-    preFilterInputCoefficients_.set(1, 2.0 * (pf_vl * pf_omega_2 - pf_vh) / pf_div);
-    preFilterInputCoefficients_.set(2, (pf_vl * pf_omega_2 - pf_vb * pf_omega_q + pf_vh) / pf_div);
-
-    preFilterOutputCoefficients_.set(0, -1.0);
-    preFilterOutputCoefficients_.set(1, -2.0 * (pf_omega_2 - 1.0) / pf_div);
-    preFilterOutputCoefficients_.set(2, -(pf_omega_2 - pf_omega_q + 1.0) / pf_div);
+    weightingFilters_.setCoefficients(
+        0,
+        (pf_vl * pf_omega_2 + pf_vb * pf_omega_q + pf_vh) / pf_div,
+        2.0 * (pf_vl * pf_omega_2 - pf_vh) / pf_div,
+        (pf_vl * pf_omega_2 - pf_vb * pf_omega_q + pf_vh) / pf_div,
+        2.0 * (pf_omega_2 - 1.0) / pf_div,
+        (pf_omega_2 - pf_omega_q + 1.0) / pf_div);
 
     // initialise RLB weighting curve (ITU-R BS.1770-1)
     double rlb_vh = 1.0;
@@ -217,168 +194,53 @@ void AverageLevelFiltered::calculateFilterKernel_ItuBs1770()
     double rlb_div_1 = (rlb_vl * rlb_omega_2 + rlb_vb * rlb_omega_q + rlb_vh);
     double rlb_div_2 = (rlb_omega_2 + rlb_omega_q + 1.0);
 
-    weightingFilterInputCoefficients_.set(0, 1.0);
-    weightingFilterInputCoefficients_.set(1, 2.0 * (rlb_vl * rlb_omega_2 - rlb_vh) / rlb_div_1);
-    weightingFilterInputCoefficients_.set(2, (rlb_vl * rlb_omega_2 - rlb_vb * rlb_omega_q + rlb_vh) / rlb_div_1);
-
-    weightingFilterOutputCoefficients_.set(0, -1.0);
-    weightingFilterOutputCoefficients_.set(1, -2.0 * (rlb_omega_2 - 1.0) / rlb_div_2);
-    weightingFilterOutputCoefficients_.set(2, -(rlb_omega_2 - rlb_omega_q + 1.0) / rlb_div_2);
-
-    calculateFilterKernel_Rms();
+    weightingFilters_.setCoefficients(
+        1,
+        1.0,
+        2.0 * (rlb_vl * rlb_omega_2 - rlb_vh) / rlb_div_1,
+        (rlb_vl * rlb_omega_2 - rlb_vb * rlb_omega_q + rlb_vh) / rlb_div_1,
+        2.0 * (rlb_omega_2 - 1.0) / rlb_div_2,
+        (rlb_omega_2 - rlb_omega_q + 1.0) / rlb_div_2);
 }
 
 
 // apply windowed-sinc low-pass filter (cutoff at 21.0 kHz) to samples
-void AverageLevelFiltered::filterSamples_Rms(
-    const int channel)
+void AverageLevelFiltered::filterSamples_Rms()
 {
-    convolveWithKernel(channel);
+    for (int channel = 0; channel < numberOfChannels_; ++channel)
+    {
+        convolveWithKernel(channel);
+    }
 }
 
 
+// apply ITU-R BS.1770-1 weighting filters to low-passed samples and
+// store the result in "weightedSampleBuffer_"; all channels are
+// filtered at once, each one in its own SIMD lane
 void AverageLevelFiltered::filterSamples_ItuBs1770()
 {
-    for (int channel = 0; channel < numberOfChannels_; ++channel)
-    {
-        // pre-filter
-        previousSamplesOutputTemp_.clear();
-        const float *samplesInput = fftSampleBuffer_.getReadPointer(channel);
-
-        // temporary buffer with only one channel
-        float *samplesOutput = previousSamplesOutputTemp_.getWritePointer(0);
-
-        const float *samplesInputOld_1 = previousSamplesPreFilterInput_.getReadPointer(channel);
-        const float *samplesOutputOld_1 = previousSamplesPreFilterOutput_.getReadPointer(channel);
-
-        for (int sample = 0; sample < fftBufferSize_; ++sample)
-        {
-            double outputSum;
-
-            if (sample < 2)
-            {
-                if (sample == 0)
-                {
-                    outputSum =
-                        preFilterInputCoefficients_[0] * samplesInput[sample] +
-                        preFilterInputCoefficients_[1] * samplesInputOld_1[1] +
-                        preFilterInputCoefficients_[2] * samplesInputOld_1[0] +
-                        preFilterOutputCoefficients_[1] * samplesOutputOld_1[1] +
-                        preFilterOutputCoefficients_[2] * samplesOutputOld_1[0];
-                }
-                else
-                {
-                    outputSum =
-                        preFilterInputCoefficients_[0] * samplesInput[sample] +
-                        preFilterInputCoefficients_[1] * samplesInput[sample - 1] +
-                        preFilterInputCoefficients_[2] * samplesInputOld_1[1] +
-                        preFilterOutputCoefficients_[1] * samplesOutput[sample - 1] +
-                        preFilterOutputCoefficients_[2] * samplesOutputOld_1[1];
-                }
-            }
-            else
-            {
-                outputSum =
-                    preFilterInputCoefficients_[0] * samplesInput[sample] +
-                    preFilterInputCoefficients_[1] * samplesInput[sample - 1] +
-                    preFilterInputCoefficients_[2] * samplesInput[sample - 2] +
-                    preFilterOutputCoefficients_[1] * samplesOutput[sample - 1] +
-                    preFilterOutputCoefficients_[2] * samplesOutput[sample - 2];
-            }
-
-            // dither output to float
-            samplesOutput[sample] = dither_.ditherSample(channel, outputSum);
-
-            // avoid underflows (1e-20f corresponds to -400 dBFS)
-            if (fabs(samplesOutput[sample]) < 1e-20f)
-            {
-                samplesOutput[sample] = 0.0f;
-            }
-        }
-
-        previousSamplesPreFilterInput_.copyFrom(
-            channel, 0, fftSampleBuffer_,
-            channel, fftBufferSize_ - 2, 2);
-
-        previousSamplesPreFilterOutput_.copyFrom(
-            channel, 0, previousSamplesOutputTemp_,
-            0, fftBufferSize_ - 2, 2);
-
-        fftSampleBuffer_.copyFrom(
-            channel, 0, previousSamplesOutputTemp_,
-            0, 0, fftBufferSize_);
-
-        // RLB weighting filter
-        previousSamplesOutputTemp_.clear();
-
-        // clearing the buffer invalidates the pointers to its sample
-        // data, so we need to update the pointers
-        samplesOutput = previousSamplesOutputTemp_.getWritePointer(0);
-
-        const float *samplesInputOld_2 = previousSamplesWeightingFilterInput_.getReadPointer(channel);
-        const float *samplesOutputOld_2 = previousSamplesWeightingFilterOutput_.getReadPointer(channel);
-
-        for (int sample = 0; sample < fftBufferSize_; ++sample)
-        {
-            double outputSum;
-
-            if (sample < 2)
-            {
-                if (sample == 0)
-                {
-                    outputSum =
-                        weightingFilterInputCoefficients_[0] * samplesInput[sample] +
-                        weightingFilterInputCoefficients_[1] * samplesInputOld_2[1] +
-                        weightingFilterInputCoefficients_[2] * samplesInputOld_2[0] +
-                        weightingFilterOutputCoefficients_[1] * samplesOutputOld_2[1] +
-                        weightingFilterOutputCoefficients_[2] * samplesOutputOld_2[0];
-                }
-                else
-                {
-                    outputSum =
-                        weightingFilterInputCoefficients_[0] * samplesInput[sample] +
-                        weightingFilterInputCoefficients_[1] * samplesInput[sample - 1] +
-                        weightingFilterInputCoefficients_[2] * samplesInputOld_2[1] +
-                        weightingFilterOutputCoefficients_[1] * samplesOutput[sample - 1] +
-                        weightingFilterOutputCoefficients_[2] * samplesOutputOld_2[1];
-                }
-            }
-            else
-            {
-                outputSum =
-                    weightingFilterInputCoefficients_[0] * samplesInput[sample] +
-                    weightingFilterInputCoefficients_[1] * samplesInput[sample - 1] +
-                    weightingFilterInputCoefficients_[2] * samplesInput[sample - 2] +
-                    weightingFilterOutputCoefficients_[1] * samplesOutput[sample - 1] +
-                    weightingFilterOutputCoefficients_[2] * samplesOutput[sample - 2];
-            }
-
-            // dither output to float
-            samplesOutput[sample] = dither_.ditherSample(channel, outputSum);
-
-            // avoid underflows (1e-20f corresponds to -400 dBFS)
-            if (fabs(samplesOutput[sample]) < 1e-20f)
-            {
-                samplesOutput[sample] = 0.0f;
-            }
-        }
-
-        previousSamplesWeightingFilterInput_.copyFrom(channel, 0, fftSampleBuffer_, channel, fftBufferSize_ - 2, 2);
-        previousSamplesWeightingFilterOutput_.copyFrom(channel, 0, previousSamplesOutputTemp_, 0, fftBufferSize_ - 2, 2);
+    weightingFilters_.process(fftSampleBuffer_,
+                              weightedSampleBuffer_,
+                              fftBufferSize_);
+}
 
-        fftSampleBuffer_.copyFrom(channel, 0, previousSamplesOutputTemp_, 0, 0, fftBufferSize_);
 
-        convolveWithKernel(channel);
-    }
+float AverageLevelFiltered::getLevel(
+    const int channel)
+{
+    return getLevel(channel, currentAlgorithm_);
 }
 
 
 float AverageLevelFiltered::getLevel(
-    const int channel)
+    const int channel,
+    const int averageAlgorithm)
 {
-    jassert(isPositiveAndNotGreaterThan(channel, numberOfChannels_));
+    jassert(isPositiveAndBelow(channel, numberOfChannels_));
+    jassert(isPositiveAndBelow(averageAlgorithm,
+                               static_cast<int>(KmeterPluginParameters::nNumAlgorithms)));
 
-    return loudnessValues_[channel];
+    return loudnessValues_[averageAlgorithm][channel];
 }
 
 
@@ -396,11 +258,16 @@ void AverageLevelFiltered::copyTo(
 
     int numberOfChannels = fftSampleBuffer_.getNumChannels();
 
+    // output of the currently selected algorithm
+    const AudioBuffer<float> &filteredSamples =
+        (currentAlgorithm_ == KmeterPluginParameters::selAlgorithmItuBs1770) ?
+        weightedSampleBuffer_ : fftSampleBuffer_;
+
     // copy data to external buffer
     for (int channel = 0; channel < numberOfChannels; ++channel)
     {
         destination.copyFrom(channel, 0,
-                             fftSampleBuffer_,
+                             filteredSamples,
                              channel, 0,
                              numberOfSamples);
     }
@@ -435,88 +302,203 @@ void AverageLevelFiltered::copyFrom(
 
 void AverageLevelFiltered::calculateLoudness()
 {
+    FRUT_PROFILE_SCOPE("AverageLevelFiltered::calculateLoudness");
+
+    // apply algorithm changes on chunk boundaries only
+    currentAlgorithm_ = averageAlgorithm_.load();
+
+    // both algorithms are always evaluated, so their filters never
+    // have to settle after the algorithm has been changed
+    //
+    // filter audio data (overwrites contents of sample buffer)
+    filterSamples_Rms();
+    filterSamples_ItuBs1770();
+
+    // use code that has been specialised for the channel count of
+    // the build target; fall back to generic code otherwise
+    if (numberOfChannels_ == KmeterPluginParameters::nNumChannels)
+    {
+        calculateLoudness_Rms<KmeterPluginParameters::nNumChannels>();
+        calculateLoudness_ItuBs1770<KmeterPluginParameters::nNumChannels>();
+    }
+    else
+    {
+        calculateLoudness_Rms<0>();
+        calculateLoudness_ItuBs1770<0>();
+    }
+}
+
+
+/// Get weighting factor of a channel according to ITU-R BS.1770-4.
+/// The factor is derived from the channel's type (and thus its
+/// loudspeaker position as defined in ITU-R BS.2051), so any layout
+/// can be measured:
+///
+/// LFE                          ==> 0.00 (skip channel)
+/// surrounds (azimuth 60-120°)  ==> 1.41 (+1.5 dB)
+/// Ambisonics (except W)        ==> 0.00 (skip channel)
+/// other                        ==> 1.00
+///
+/// @param channelSet channel layout
+///
+/// @param channel channel index
+///
+/// @return weighting factor
+///
+float AverageLevelFiltered::getChannelWeight(
+    const AudioChannelSet &channelSet,
+    const int channel)
+{
+    AudioChannelSet::ChannelType channelType =
+        channelSet.getTypeOfChannel(channel);
+
+    // only the omnidirectional component of an Ambisonics bed
+    // contains the full signal
+    if (channelSet.getAmbisonicOrder() >= 0)
+    {
+        return (channelType == AudioChannelSet::ambisonicW) ? 1.00f : 0.00f;
+    }
+
+    switch (channelType)
+    {
+    case AudioChannelSet::LFE:
+    case AudioChannelSet::LFE2:
+        return 0.00f;
+
+    case AudioChannelSet::leftSurround:
+    case AudioChannelSet::rightSurround:
+    case AudioChannelSet::leftSurroundSide:
+    case AudioChannelSet::rightSurroundSide:
+    case AudioChannelSet::wideLeft:
+    case AudioChannelSet::wideRight:
+        return 1.41f;
+
+    default:
+        return 1.00f;
+    }
+}
+
+
+/// Calculate RMS levels.
+///
+/// @tparam NumberOfChannels number of channels known at compile
+///         time, or zero to use the number of channels passed to the
+///         constructor
+///
+template <int NumberOfChannels>
+void AverageLevelFiltered::calculateLoudness_Rms()
+{
+    const int numberOfChannels = (NumberOfChannels > 0) ?
+                                 NumberOfChannels : numberOfChannels_;
+    jassert(numberOfChannels == numberOfChannels_);
+
     float meterMinimumDecibel = MeterBallistics::getMeterMinimumDecibel();
+    float *loudnessValues = loudnessValues_[
+                                KmeterPluginParameters::selAlgorithmRms].getRawDataPointer();
+
+    // RMS peak-to-average gain correction; this is simply the level
+    // difference between the peak and RMS level of a sine wave: RMS /
+    // A = sqrt(2) = +3.0103 dB
+    float peakToAverageCorrection = +3.0103f;
 
-    if (averageAlgorithm_ == KmeterPluginParameters::selAlgorithmItuBs1770)
+    for (int channel = 0; channel < numberOfChannels; ++channel)
     {
-        // filter audio data (overwrites contents of sample buffer)
-        filterSamples_ItuBs1770();
+        float rmsLevel = fftSampleBuffer_.getRMSLevel(
+                             channel, 0, fftBufferSize_);
 
-        float averageLevel = 0.0f;
+        float averageLevel = useExactConversion_ ?
+                             MeterBallistics::level2decibel(rmsLevel) :
+                             MeterBallistics::level2decibel_fast(rmsLevel);
 
-        for (int channel = 0; channel < numberOfChannels_; ++channel)
+        // apply peak-to-average gain correction so that sine waves
+        // read the same on peak and average meters
+        averageLevel += peakToAverageCorrection;
+
+        if (averageLevel < meterMinimumDecibel)
         {
-            float averageLevelChannel = 0.0f;
-            const float *sampleData = fftSampleBuffer_.getReadPointer(channel);
-
-            // calculate mean square of the filtered input signal
-            for (int n = 0; n < fftBufferSize_; ++n)
-            {
-                averageLevelChannel += (sampleData[n] * sampleData[n]);
-            }
-
-            averageLevelChannel /= float(fftBufferSize_);
-
-            // apply weighting factor and sum channels
-            //
-            // L, R, C  ==> 1.00 (ignore factor)
-            // LFE      ==> 0.00 (skip channel)
-            // LS, RS   ==> 1.41
-            // other    ==> 0.00 (skip channel)
-            if (channel < 3)
-            {
-                averageLevel += averageLevelChannel;
-            }
-            else if (channel == 4)
-            {
-                averageLevel += 1.41f * averageLevelChannel;
-            }
-            else if (channel == 5)
-            {
-                averageLevel += 1.41f * averageLevelChannel;
-            }
+            averageLevel = meterMinimumDecibel;
         }
 
-        // calculate loudness by applying the formula from ITU-R
-        // BS.1770-1; here's my guess to what the factors mean:
-        //
-        // -0.691 => 'K' filter frequency response at 1 kHz
-        // 10.000 => factor for conversion to decibels (20.0) and
-        //           square root for conversion from mean square
-        //           to RMS (log10(sqrt(x)) = 0.5 * log10(x))
-        float loudness = -0.691f + 10.0f * log10f(averageLevel);
+        loudnessValues[channel] = averageLevel;
+    }
+}
+
+
+/// Calculate loudness according to ITU-R BS.1770-1.
+///
+/// @tparam NumberOfChannels number of channels known at compile
+///         time, or zero to use the number of channels passed to the
+///         constructor
+///
+template <int NumberOfChannels>
+void AverageLevelFiltered::calculateLoudness_ItuBs1770()
+{
+    const int numberOfChannels = (NumberOfChannels > 0) ?
+                                 NumberOfChannels : numberOfChannels_;
+    jassert(numberOfChannels == numberOfChannels_);
+
+    float meterMinimumDecibel = MeterBallistics::getMeterMinimumDecibel();
+    float *loudnessValues = loudnessValues_[
+                                KmeterPluginParameters::selAlgorithmItuBs1770].getRawDataPointer();
+    const float *channelWeights = channelWeights_.getRawDataPointer();
+    float averageLevel = 0.0f;
+
+    for (int channel = 0; channel < numberOfChannels; ++channel)
+    {
+        float channelWeight = channelWeights[channel];
 
-        if (loudness < meterMinimumDecibel)
+        // skipped channels do not contribute to loudness
+        if (channelWeight == 0.0f)
         {
-            loudness = meterMinimumDecibel;
+            continue;
         }
 
-        for (int channel = 0; channel < numberOfChannels_; ++channel)
+        float averageLevelChannel = 0.0f;
+        const float *sampleData = weightedSampleBuffer_.getReadPointer(channel);
+
+        // calculate mean square of the filtered input signal
+        for (int n = 0; n < fftBufferSize_; ++n)
         {
-            loudnessValues_.set(channel, loudness);
+            averageLevelChannel += (sampleData[n] * sampleData[n]);
         }
+
+        averageLevelChannel /= float(fftBufferSize_);
+
+        // apply weighting factor and sum channels
+        averageLevel += channelWeight * averageLevelChannel;
     }
-    else
-    {
-        for (int channel = 0; channel < numberOfChannels_; ++channel)
-        {
-            // filter audio data (overwrites contents of sample buffer)
-            filterSamples_Rms(channel);
 
-            float averageLevel = MeterBallistics::level2decibel(
-                                     fftSampleBuffer_.getRMSLevel(
-                                         channel, 0, fftBufferSize_));
+    // calculate loudness by applying the formula from ITU-R
+    // BS.1770-1; here's my guess to what the factors mean:
+    //
+    // -0.691 => 'K' filter frequency response at 1 kHz
+    // 10.000 => factor for conversion to decibels (20.0) and
+    //           square root for conversion from mean square
+    //           to RMS (log10(sqrt(x)) = 0.5 * log10(x))
+    //
+    // ITU-R BS.1770-1 provides its own peak-to-average gain
+    // correction, so we don't need to apply any!
+    float loudness;
 
-            // apply peak-to-average gain correction so that sine
-            // waves read the same on peak and average meters
-            averageLevel += peakToAverageCorrection_;
+    if (useExactConversion_)
+    {
+        loudness = -0.691f + 10.0f * log10f(averageLevel);
+    }
+    else
+    {
+        // the fast conversion takes levels, so convert mean square
+        // to RMS
+        loudness = -0.691f + MeterBallistics::level2decibel_fast(
+                       sqrtf(averageLevel));
+    }
 
-            if (averageLevel < meterMinimumDecibel)
-            {
-                averageLevel = meterMinimumDecibel;
-            }
+    if (loudness < meterMinimumDecibel)
+    {
+        loudness = meterMinimumDecibel;
+    }
 
-            loudnessValues_.set(channel, averageLevel);
-        }
+    for (int channel = 0; channel < numberOfChannels; ++channel)
+    {
+        loudnessValues[channel] = loudness;
     }
 }
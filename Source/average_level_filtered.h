@@ -34,9 +34,7 @@ class AverageLevelFiltered :
     public frut::dsp::FIRFilterBox
 {
 public:
-    static const int KMETER_MAXIMUM_FILTER_STAGES = 3;
-
-    AverageLevelFiltered(const int numberOfChannels,
+    AverageLevelFiltered(const AudioChannelSet &channelSet,
                          const double sampleRate,
                          const int fftBufferSize,
                          const int averageAlgorithm);
@@ -47,7 +45,11 @@ public:
     int getAlgorithm() const;
     void setAlgorithm(const int averageAlgorithm);
 
+    void setExactConversion(const bool useExactConversion);
+
     float getLevel(const int channel);
+    float getLevel(const int channel,
+                   const int averageAlgorithm);
 
     void copyTo(AudioBuffer<float> &destination,
                 const int numberOfSamples);
@@ -63,31 +65,37 @@ private:
     void calculateFilterKernel_ItuBs1770();
 
     void calculateLoudness();
-    void filterSamples_Rms(const int channel);
-    void filterSamples_ItuBs1770();
 
-    double sampleRate_;
+    template <int NumberOfChannels>
+    void calculateLoudness_Rms();
 
-    Array<float> loudnessValues_;
+    template <int NumberOfChannels>
+    void calculateLoudness_ItuBs1770();
 
-    Array<double> preFilterInputCoefficients_;
-    Array<double> preFilterOutputCoefficients_;
+    static float getChannelWeight(const AudioChannelSet &channelSet,
+                                  const int channel);
+
+    void filterSamples_Rms();
+    void filterSamples_ItuBs1770();
+
+    double sampleRate_;
 
-    Array<double> weightingFilterInputCoefficients_;
-    Array<double> weightingFilterOutputCoefficients_;
+    Array<float> loudnessValues_[KmeterPluginParameters::nNumAlgorithms];
+    Array<float> channelWeights_;
 
-    AudioBuffer<float> previousSamplesPreFilterInput_;
-    AudioBuffer<float> previousSamplesPreFilterOutput_;
+    AudioBuffer<float> weightedSampleBuffer_;
 
-    AudioBuffer<float> previousSamplesWeightingFilterInput_;
-    AudioBuffer<float> previousSamplesWeightingFilterOutput_;
+    frut::dsp::InterleavedBiquadFilter weightingFilters_;
 
-    AudioBuffer<float> previousSamplesOutputTemp_;
+    // selected algorithm; may be changed from any thread and is
+    // applied at the start of the next chunk
+    std::atomic<int> averageAlgorithm_;
 
-    frut::dsp::Dither dither_;
+    // algorithm that was selected when the current chunk was
+    // processed
+    int currentAlgorithm_;
 
-    int averageAlgorithm_;
-    float peakToAverageCorrection_;
+    bool useExactConversion_;
 };
 
 #endif  // KMETER_AVERAGE_LEVEL_FILTERED_H
@@ -0,0 +1,299 @@
+/* ----------------------------------------------------------------------------
+
+   K-Meter
+   =======
+   Implementation of a K-System meter according to Bob Katz' specifications
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "kmeter_bench.h"
+#include "../average_level_filtered.h"
+#include "../meter_ballistics.h"
+#include "../plugin_parameters.h"
+
+
+/// Write result of a building block benchmark to the standard
+/// output.
+///
+/// @param name name of benchmarked code
+///
+/// @param ticks high-resolution ticks spent in benchmarked code
+///
+/// @param numberOfSamples number of processed samples per channel
+///
+/// @param numberOfChannels number of processed channels
+///
+/// @param sampleRate sample rate of processed audio
+///
+void KmeterBenchmarks::reportBuildingBlock(
+    const String &name,
+    const int64 ticks,
+    const int numberOfSamples,
+    const int numberOfChannels,
+    const double sampleRate)
+{
+    double seconds = Time::highResolutionTicksToSeconds(ticks);
+    double audioSeconds = numberOfSamples / sampleRate;
+
+    double nanoSecondsPerSample = 1e9 * seconds /
+                                  (static_cast<double>(numberOfSamples) * numberOfChannels);
+    double realTimeFactor = (seconds > 0.0) ? audioSeconds / seconds : 0.0;
+
+    print("  " +
+          name.paddedRight(' ', 32) +
+          String(nanoSecondsPerSample, 2).paddedLeft(' ', 9) +
+          " ns/sample" +
+          String(realTimeFactor, 1).paddedLeft(' ', 10) +
+          "x real-time");
+}
+
+
+/// Benchmark the hot paths of the DSP and audio building blocks in
+/// isolation for several channel counts and sample rates.  The
+/// results (nanoseconds per sample and channel, real-time factor) are
+/// written to the standard output.
+///
+void KmeterBenchmarks::benchmarkBuildingBlocks()
+{
+    const int chunkSize = 1024;
+    const int numberOfChunks = 200;
+    const int numberOfSamples = numberOfChunks * chunkSize;
+    const int maximumBlockSize = 2048;
+
+    const int channelCounts[] = {1, 2, 6};
+    const double sampleRates[] = {44100.0, 96000.0, 192000.0};
+
+    // use fixed seed so that all runs process identical data
+    Random random(42);
+
+    for (double sampleRate : sampleRates)
+    {
+        // same oversampling factors as in "prepareToPlay"
+        int oversamplingFactor = 8;
+
+        if (sampleRate >= 176400)
+        {
+            oversamplingFactor /= 4;
+        }
+        else if (sampleRate >= 88200)
+        {
+            oversamplingFactor /= 2;
+        }
+
+        for (int numberOfChannels : channelCounts)
+        {
+            print("building blocks: " +
+                  String(numberOfChannels) + " channel(s), " +
+                  String(sampleRate, 0) + " Hz");
+
+            AudioBuffer<float> noise(numberOfChannels, maximumBlockSize);
+            AudioBuffer<double> noiseDouble(numberOfChannels, maximumBlockSize);
+
+            for (int channel = 0; channel < numberOfChannels; ++channel)
+            {
+                for (int sample = 0; sample < maximumBlockSize; ++sample)
+                {
+                    float value = random.nextFloat() - 0.5f;
+
+                    noise.setSample(channel, sample, value);
+                    noiseDouble.setSample(channel, sample, value);
+                }
+            }
+
+            int64 startTicks;
+
+            // true peak meter (upsampling and FFT convolution)
+            frut::dsp::TruePeakMeter truePeakMeter(numberOfChannels,
+                                                   chunkSize,
+                                                   oversamplingFactor);
+
+            startTicks = Time::getHighResolutionTicks();
+
+            for (int chunk = 0; chunk < numberOfChunks; ++chunk)
+            {
+                truePeakMeter.copyFrom(noise, chunkSize);
+            }
+
+            reportBuildingBlock("TruePeakMeter::copyFrom (" + String(oversamplingFactor) + "x)",
+                                Time::getHighResolutionTicks() - startTicks,
+                                numberOfSamples, numberOfChannels, sampleRate);
+
+            // convolution only (re-uses the meter's upsampled buffer)
+            frut::dsp::FftwRunner &fftwRunner = truePeakMeter;
+
+            startTicks = Time::getHighResolutionTicks();
+
+            for (int chunk = 0; chunk < numberOfChunks; ++chunk)
+            {
+                for (int channel = 0; channel < numberOfChannels; ++channel)
+                {
+                    fftwRunner.convolveWithKernel(
+                        channel, static_cast<float>(oversamplingFactor));
+                }
+            }
+
+            reportBuildingBlock("FftwRunner::convolveWithKernel",
+                                Time::getHighResolutionTicks() - startTicks,
+                                numberOfSamples, numberOfChannels, sampleRate);
+
+            // average level filter
+            AudioChannelSet channelSet =
+                AudioChannelSet::canonicalChannelSet(numberOfChannels);
+
+            for (int algorithm = 0;
+                    algorithm < KmeterPluginParameters::nNumAlgorithms;
+                    ++algorithm)
+            {
+                AverageLevelFiltered averageLevelFiltered(channelSet,
+                                                          sampleRate,
+                                                          chunkSize,
+                                                          algorithm);
+
+                startTicks = Time::getHighResolutionTicks();
+
+                for (int chunk = 0; chunk < numberOfChunks; ++chunk)
+                {
+                    averageLevelFiltered.copyFrom(noise, chunkSize);
+                }
+
+                String algorithmName = (algorithm == KmeterPluginParameters::selAlgorithmItuBs1770) ?
+                                       "ITU-R" : "RMS";
+
+                reportBuildingBlock("AverageLevelFiltered (" + algorithmName + ")",
+                                    Time::getHighResolutionTicks() - startTicks,
+                                    numberOfSamples, numberOfChannels, sampleRate);
+            }
+
+            // ring buffers with random host block sizes
+            frut::audio::RingBuffer<float> ringBuffer(
+                numberOfChannels, maximumBlockSize + chunkSize,
+                chunkSize, chunkSize);
+            frut::audio::RingBuffer<double> ringBufferDouble(
+                numberOfChannels, maximumBlockSize + chunkSize,
+                chunkSize, chunkSize);
+
+            int64 floatTicks = 0;
+            int64 doubleTicks = 0;
+
+            for (int processedSamples = 0; processedSamples < numberOfSamples;)
+            {
+                int blockSize = jmin(random.nextInt(Range<int>(16, maximumBlockSize + 1)),
+                                     numberOfSamples - processedSamples);
+
+                startTicks = Time::getHighResolutionTicks();
+
+                ringBuffer.addFrom(noise, 0, blockSize);
+                ringBuffer.removeTo(noise, 0, blockSize);
+
+                floatTicks += Time::getHighResolutionTicks() - startTicks;
+                startTicks = Time::getHighResolutionTicks();
+
+                ringBufferDouble.addFrom(noiseDouble, 0, blockSize);
+                ringBufferDouble.removeTo(noiseDouble, 0, blockSize);
+
+                doubleTicks += Time::getHighResolutionTicks() - startTicks;
+                processedSamples += blockSize;
+            }
+
+            reportBuildingBlock("RingBuffer<float>", floatTicks,
+                                numberOfSamples, numberOfChannels, sampleRate);
+            reportBuildingBlock("RingBuffer<double>", doubleTicks,
+                                numberOfSamples, numberOfChannels, sampleRate);
+
+            // dither
+            frut::dsp::Dither dither;
+            dither.initialise(numberOfChannels, 24);
+
+            startTicks = Time::getHighResolutionTicks();
+
+            for (int chunk = 0; chunk < numberOfChunks; ++chunk)
+            {
+                for (int channel = 0; channel < numberOfChannels; ++channel)
+                {
+                    const double *samples = noiseDouble.getReadPointer(channel);
+
+                    for (int sample = 0; sample < chunkSize; ++sample)
+                    {
+                        noise.setSample(channel, sample,
+                                        dither.ditherSample(channel, samples[sample]));
+                    }
+                }
+            }
+
+            reportBuildingBlock("Dither::ditherSample",
+                                Time::getHighResolutionTicks() - startTicks,
+                                numberOfSamples, numberOfChannels, sampleRate);
+
+            AudioBuffer<float> ditherOutput(numberOfChannels, chunkSize);
+            AudioBuffer<double> ditherInput(numberOfChannels, chunkSize);
+
+            for (int channel = 0; channel < numberOfChannels; ++channel)
+            {
+                ditherInput.copyFrom(channel, 0, noiseDouble, channel, 0, chunkSize);
+            }
+
+            startTicks = Time::getHighResolutionTicks();
+
+            for (int chunk = 0; chunk < numberOfChunks; ++chunk)
+            {
+                dither.ditherToFloat(ditherInput, ditherOutput);
+            }
+
+            reportBuildingBlock("Dither::ditherToFloat",
+                                Time::getHighResolutionTicks() - startTicks,
+                                numberOfSamples, numberOfChannels, sampleRate);
+
+            // meter ballistics (one update per chunk)
+            MeterBallistics meterBallistics(numberOfChannels,
+                                            KmeterPluginParameters::selAlgorithmItuBs1770,
+                                            false,
+                                            false);
+
+            Array<float> peakLevels;
+            Array<float> averageLevels;
+            Array<int> overflowCounts;
+
+            for (int channel = 0; channel < numberOfChannels; ++channel)
+            {
+                peakLevels.add(noise.getMagnitude(channel, 0, chunkSize));
+                averageLevels.add(-20.0f);
+                overflowCounts.add(0);
+            }
+
+            float timePassed = static_cast<float>(chunkSize / sampleRate);
+            startTicks = Time::getHighResolutionTicks();
+
+            for (int chunk = 0; chunk < numberOfChunks; ++chunk)
+            {
+                meterBallistics.updateChannels(timePassed,
+                                               peakLevels.getRawDataPointer(),
+                                               peakLevels.getRawDataPointer(),
+                                               averageLevels.getRawDataPointer(),
+                                               overflowCounts.getRawDataPointer());
+            }
+
+            reportBuildingBlock("MeterBallistics::updateChannels",
+                                Time::getHighResolutionTicks() - startTicks,
+                                numberOfSamples, numberOfChannels, sampleRate);
+
+            print("");
+        }
+    }
+}
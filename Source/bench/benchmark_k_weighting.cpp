@@ -0,0 +1,199 @@
+/* ----------------------------------------------------------------------------
+
+   K-Meter
+   =======
+   Implementation of a K-System meter according to Bob Katz' specifications
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "kmeter_bench.h"
+
+
+// K-weighting filters of ITU-R BS.1770 at 48 kHz (a0, a1, a2, b1, b2)
+static const double kWeightingCoefficients[2][5] =
+{
+    // pre-filter
+    {
+        1.53512485958697, -2.69169618940638, 1.19839281085285,
+        -1.69065929318241, 0.73248077421585
+    },
+    // RLB weighting curve
+    {
+        1.0, -2.0, 1.0,
+        -1.99004745483398, 0.99007225036621
+    }
+};
+
+
+/// Reference implementation of the K-weighting filters that filters
+/// one channel after the other.  This is how "AverageLevelFiltered"
+/// used to filter before it switched to interleaved processing.
+///
+class PlanarKWeighting
+{
+public:
+    explicit PlanarKWeighting(const int numberOfChannels) :
+        numberOfChannels_(numberOfChannels),
+        delays_(static_cast<size_t>(numberOfChannels * numberOfStages * 4), true)
+    {
+    }
+
+
+    void process(const AudioBuffer<float> &inputBuffer,
+                 AudioBuffer<float> &outputBuffer,
+                 const int numberOfSamples)
+    {
+        for (int channel = 0; channel < numberOfChannels_; ++channel)
+        {
+            const float *input = inputBuffer.getReadPointer(channel);
+            float *output = outputBuffer.getWritePointer(channel);
+
+            for (int sample = 0; sample < numberOfSamples; ++sample)
+            {
+                double value = input[sample];
+
+                for (int stage = 0; stage < numberOfStages; ++stage)
+                {
+                    const double *coefficients = kWeightingCoefficients[stage];
+
+                    // direct form I: x[n-1], x[n-2], y[n-1], y[n-2]
+                    double *delays = delays_.get() +
+                                     (channel * numberOfStages + stage) * 4;
+
+                    double result = coefficients[0] * value +
+                                    coefficients[1] * delays[0] +
+                                    coefficients[2] * delays[1] -
+                                    coefficients[3] * delays[2] -
+                                    coefficients[4] * delays[3];
+
+                    delays[1] = delays[0];
+                    delays[0] = value;
+                    delays[3] = delays[2];
+                    delays[2] = result;
+
+                    value = result;
+                }
+
+                output[sample] = static_cast<float>(value);
+            }
+        }
+    }
+
+private:
+    static const int numberOfStages = 2;
+
+    int numberOfChannels_;
+    HeapBlock<double> delays_;
+};
+
+
+/// Benchmark the interleaved K-weighting filters (one channel per
+/// SIMD lane) against the planar reference implementation for
+/// several channel counts.  Both outputs are compared to make sure
+/// that the implementations agree.  The results are written to the
+/// standard output.
+///
+void KmeterBenchmarks::benchmarkKWeighting()
+{
+    const int chunkSize = 1024;
+    const int numberOfChunks = 500;
+    const int channelCounts[] = {1, 2, 6, 8, 12, 16};
+
+    print("K-weighting (48000 Hz, planar / interleaved)");
+
+    // use fixed seed so that all runs process identical data
+    Random random(42);
+
+    for (int numberOfChannels : channelCounts)
+    {
+        AudioBuffer<float> noise(numberOfChannels, chunkSize);
+        AudioBuffer<float> planarOutput(numberOfChannels, chunkSize);
+        AudioBuffer<float> interleavedOutput(numberOfChannels, chunkSize);
+
+        for (int channel = 0; channel < numberOfChannels; ++channel)
+        {
+            for (int sample = 0; sample < chunkSize; ++sample)
+            {
+                noise.setSample(channel, sample, random.nextFloat() - 0.5f);
+            }
+        }
+
+        PlanarKWeighting planarFilter(numberOfChannels);
+        frut::dsp::InterleavedBiquadFilter interleavedFilter(
+            numberOfChannels, 2, chunkSize);
+
+        for (int stage = 0; stage < 2; ++stage)
+        {
+            const double *coefficients = kWeightingCoefficients[stage];
+
+            interleavedFilter.setCoefficients(
+                stage,
+                coefficients[0], coefficients[1], coefficients[2],
+                coefficients[3], coefficients[4]);
+        }
+
+        int64 startTicks = Time::getHighResolutionTicks();
+
+        for (int chunk = 0; chunk < numberOfChunks; ++chunk)
+        {
+            planarFilter.process(noise, planarOutput, chunkSize);
+        }
+
+        int64 planarTicks = Time::getHighResolutionTicks() - startTicks;
+        startTicks = Time::getHighResolutionTicks();
+
+        for (int chunk = 0; chunk < numberOfChunks; ++chunk)
+        {
+            interleavedFilter.process(noise, interleavedOutput, chunkSize);
+        }
+
+        int64 interleavedTicks = Time::getHighResolutionTicks() - startTicks;
+
+        // both filters have processed the same samples, so their
+        // last outputs must agree
+        float maximumDeviation = 0.0f;
+
+        for (int channel = 0; channel < numberOfChannels; ++channel)
+        {
+            for (int sample = 0; sample < chunkSize; ++sample)
+            {
+                maximumDeviation = jmax(maximumDeviation, std::abs(
+                                            planarOutput.getSample(channel, sample) -
+                                            interleavedOutput.getSample(channel, sample)));
+            }
+        }
+
+        double numberOfSamples = static_cast<double>(numberOfChunks) *
+                                 chunkSize * numberOfChannels;
+
+        double planarNanoSeconds = 1e9 * Time::highResolutionTicksToSeconds(
+                                       planarTicks) / numberOfSamples;
+        double interleavedNanoSeconds = 1e9 * Time::highResolutionTicksToSeconds(
+                                            interleavedTicks) / numberOfSamples;
+
+        print("  " +
+              String(numberOfChannels).paddedLeft(' ', 2) + " channel(s)" +
+              String(planarNanoSeconds, 2).paddedLeft(' ', 9) + " ns/sample" +
+              String(interleavedNanoSeconds, 2).paddedLeft(' ', 9) + " ns/sample" +
+              "    max. deviation " + String(maximumDeviation, 9));
+    }
+
+    print("");
+}
@@ -0,0 +1,312 @@
+/* ----------------------------------------------------------------------------
+
+   K-Meter
+   =======
+   Implementation of a K-System meter according to Bob Katz' specifications
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "kmeter_bench.h"
+#include "../plugin_processor.h"
+
+
+/// Deterministic test signal for benchmarking "processBlock".
+///
+struct BenchmarkSignal
+{
+    enum SignalType
+    {
+        pinkNoise = 0,
+        sineWave,
+        silence,
+
+        numberOfTypes
+    };
+
+
+    BenchmarkSignal(const int signalType, const double sampleRate) :
+        type(signalType),
+        // 997 Hz avoids aliasing with common block sizes
+        phaseIncrement(MathConstants<double>::twoPi * 997.0 / sampleRate),
+        phase(0.0),
+        random(42),
+        pink0(0.0f),
+        pink1(0.0f),
+        pink2(0.0f)
+    {
+    }
+
+
+    static String getName(const int signalType)
+    {
+        switch (signalType)
+        {
+            case pinkNoise:
+                return "pink noise";
+
+            case sineWave:
+                return "sine";
+
+            default:
+                return "silence";
+        }
+    }
+
+
+    // Thanks to Paul Kellet for the pink noise filter!
+    // (http://www.musicdsp.org/showone.php?id=76)
+    template <typename Type>
+    void fill(AudioBuffer<Type> &buffer)
+    {
+        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        {
+            float value = 0.0f;
+
+            if (type == pinkNoise)
+            {
+                float white = random.nextFloat() * 2.0f - 1.0f;
+
+                pink0 = 0.99765f * pink0 + white * 0.0990460f;
+                pink1 = 0.96300f * pink1 + white * 0.2965164f;
+                pink2 = 0.57000f * pink2 + white * 1.0526913f;
+
+                value = 0.05f * (pink0 + pink1 + pink2 + white * 0.1848f);
+            }
+            else if (type == sineWave)
+            {
+                value = 0.5f * static_cast<float>(std::sin(phase));
+                phase = std::fmod(phase + phaseIncrement,
+                                  MathConstants<double>::twoPi);
+            }
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            {
+                buffer.setSample(channel, sample, static_cast<Type>(value));
+            }
+        }
+    }
+
+
+    int type;
+    double phaseIncrement;
+    double phase;
+
+    Random random;
+
+    float pink0;
+    float pink1;
+    float pink2;
+};
+
+
+/// Feed "processBlock" with a test signal like a host would and
+/// measure the time spent in each callback.
+///
+/// @param processor prepared audio processor
+///
+/// @param signal test signal
+///
+/// @param numberOfChannels number of channels in audio buffer
+///
+/// @param blockSize number of samples per callback
+///
+/// @param numberOfBlocks number of callbacks
+///
+/// @param meanLoad receives mean callback time as fraction of the
+///        deadline
+///
+/// @param maximumLoad receives worst-case callback time as fraction
+///        of the deadline
+///
+template <typename Type>
+static void runProcessingBenchmark(
+    AudioProcessor &processor,
+    BenchmarkSignal &signal,
+    const int numberOfChannels,
+    const int blockSize,
+    const int numberOfBlocks,
+    double &meanLoad,
+    double &maximumLoad)
+{
+    AudioBuffer<Type> buffer(numberOfChannels, blockSize);
+    MidiBuffer midiMessages;
+
+    double deadlineSeconds = blockSize / processor.getSampleRate();
+    double sumOfLoads = 0.0;
+
+    maximumLoad = 0.0;
+
+    for (int block = 0; block < numberOfBlocks; ++block)
+    {
+        signal.fill(buffer);
+
+        int64 startTicks = Time::getHighResolutionTicks();
+        processor.processBlock(buffer, midiMessages);
+        int64 elapsedTicks = Time::getHighResolutionTicks() - startTicks;
+
+        double load = Time::highResolutionTicksToSeconds(elapsedTicks) /
+                      deadlineSeconds;
+
+        sumOfLoads += load;
+        maximumLoad = jmax(maximumLoad, load);
+    }
+
+    meanLoad = sumOfLoads / numberOfBlocks;
+}
+
+
+/// Benchmark "processBlock" end-to-end with a simulated host.  One
+/// instance is created for each of stereo, 5.1, 7.1, 7.1.4 and 16
+/// channels (where supported by the build) and re-prepared for single
+/// and double precision, several sample rates and block sizes from 16
+/// to 8192 samples.  It is fed with pink noise, a sine wave and
+/// digital silence.  Mean and worst-case callback times are written
+/// to the standard output as percentages of the deadline; the worst
+/// case reveals spikes on chunk boundaries.
+///
+/// The CPU budget is lifted during the benchmark, so the CPU governor
+/// never steps down to reduced processing.
+///
+void KmeterBenchmarks::benchmarkProcessing()
+{
+    const double secondsPerRun = 2.0;
+    const double sampleRates[] = {44100.0, 48000.0, 96000.0, 192000.0};
+
+    Array<AudioChannelSet> channelSets;
+    channelSets.add(AudioChannelSet::stereo());
+    channelSets.add(AudioChannelSet::create5point1());
+    channelSets.add(AudioChannelSet::create7point1());
+
+    // 7.1.4 (JUCE 5 has no factory for this layout)
+    channelSets.add(AudioChannelSet::channelSetWithChannels(
+    {
+        AudioChannelSet::left,
+        AudioChannelSet::right,
+        AudioChannelSet::centre,
+        AudioChannelSet::LFE,
+        AudioChannelSet::leftSurroundSide,
+        AudioChannelSet::rightSurroundSide,
+        AudioChannelSet::leftSurroundRear,
+        AudioChannelSet::rightSurroundRear,
+        AudioChannelSet::topFrontLeft,
+        AudioChannelSet::topFrontRight,
+        AudioChannelSet::topRearLeft,
+        AudioChannelSet::topRearRight
+    }));
+
+    // 16 channels is the maximum supported by the surround build
+    channelSets.add(AudioChannelSet::ambisonic(3));
+
+    // measure full processing only, even on slow machines
+    float previousBudget = frut::audio::CpuGovernor::getBudget();
+    frut::audio::CpuGovernor::setBudget(std::numeric_limits<float>::max());
+
+    print("processBlock (mean / worst case in % of deadline)");
+
+    for (const auto &channelSet : channelSets)
+    {
+        KmeterAudioProcessor processor;
+
+        AudioProcessor::BusesLayout busesLayout;
+        busesLayout.inputBuses.add(channelSet);
+        busesLayout.outputBuses.add(channelSet);
+
+        if (!processor.setBusesLayout(busesLayout))
+        {
+            print("  " + channelSet.getDescription() +
+                  ": not supported by this build");
+            continue;
+        }
+
+        // benchmark the full processing path (meters are displayed)
+        processor.setEditorOpen(true);
+
+        int numberOfChannels = channelSet.size();
+
+        for (int precision = 0; precision < 2; ++precision)
+        {
+            bool useDoublePrecision = (precision == 1);
+
+            if (useDoublePrecision && !processor.supportsDoublePrecisionProcessing())
+            {
+                print("  " + channelSet.getDescription() +
+                      ", double: not supported by this build");
+                continue;
+            }
+
+            processor.setProcessingPrecision(useDoublePrecision ?
+                                             AudioProcessor::doublePrecision :
+                                             AudioProcessor::singlePrecision);
+
+            for (double sampleRate : sampleRates)
+            {
+                for (int blockSize = 16; blockSize <= 8192; blockSize *= 2)
+                {
+                    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+                    processor.prepareToPlay(sampleRate, blockSize);
+
+                    int numberOfBlocks = jmax(1, roundToInt(
+                                                  secondsPerRun * sampleRate / blockSize));
+
+                    for (int signalType = 0;
+                            signalType < BenchmarkSignal::numberOfTypes;
+                            ++signalType)
+                    {
+                        BenchmarkSignal signal(signalType, sampleRate);
+
+                        double meanLoad;
+                        double maximumLoad;
+
+                        if (useDoublePrecision)
+                        {
+                            runProcessingBenchmark<double>(
+                                processor, signal, numberOfChannels,
+                                blockSize, numberOfBlocks,
+                                meanLoad, maximumLoad);
+                        }
+                        else
+                        {
+                            runProcessingBenchmark<float>(
+                                processor, signal, numberOfChannels,
+                                blockSize, numberOfBlocks,
+                                meanLoad, maximumLoad);
+                        }
+
+                        print(
+                            "  " +
+                            channelSet.getDescription().paddedRight(' ', 12) +
+                            (useDoublePrecision ? "double  " : "float   ") +
+                            String(sampleRate, 0).paddedLeft(' ', 6) + " Hz" +
+                            String(blockSize).paddedLeft(' ', 6) + " samples  " +
+                            BenchmarkSignal::getName(signalType).paddedRight(' ', 12) +
+                            String(100.0 * meanLoad, 2).paddedLeft(' ', 8) + " %" +
+                            String(100.0 * maximumLoad, 2).paddedLeft(' ', 8) + " %");
+                    }
+                }
+            }
+        }
+
+        processor.releaseResources();
+    }
+
+    frut::audio::CpuGovernor::setBudget(previousBudget);
+
+    print("");
+}
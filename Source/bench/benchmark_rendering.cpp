@@ -0,0 +1,184 @@
+/* ----------------------------------------------------------------------------
+
+   K-Meter
+   =======
+   Implementation of a K-System meter according to Bob Katz' specifications
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "kmeter_bench.h"
+#include "../plugin_editor.h"
+
+
+/// Benchmark rendering of the editor without showing it on screen.
+/// Editors for stereo and 5.1 layouts are rendered into an offscreen
+/// image in continuous and discrete mode, expanded and normal.
+/// Their meters are driven by a deterministic level trace at 60
+/// frames per second.  Time per frame and the area that changed
+/// between frames (an estimate of what needs to be repainted) are
+/// written to the standard output.  Must be called from the message
+/// thread.
+///
+void KmeterBenchmarks::benchmarkRendering()
+{
+    const int numberOfFrames = 300;
+    const float framePeriod = 1.0f / 60.0f;
+
+    Array<AudioChannelSet> channelSets;
+    channelSets.add(AudioChannelSet::stereo());
+    channelSets.add(AudioChannelSet::create5point1());
+
+    print("rendering (per frame)");
+
+    for (const auto &channelSet : channelSets)
+    {
+        for (int mode = 0; mode < 4; ++mode)
+        {
+            bool isDiscrete = (mode & 1) != 0;
+            bool isExpandedMode = (mode & 2) != 0;
+
+            // the editor reads all settings from the processor, so
+            // it does not need to be prepared; display one meter per
+            // channel
+            KmeterAudioProcessor processor;
+
+            processor.changeParameter(
+                KmeterPluginParameters::selAverageAlgorithm,
+                KmeterPluginParameters::selAlgorithmRms /
+                float(KmeterPluginParameters::nNumAlgorithms - 1));
+            processor.changeParameter(
+                KmeterPluginParameters::selDiscreteMeter,
+                isDiscrete ? 1.0f : 0.0f);
+            processor.changeParameter(
+                KmeterPluginParameters::selExpanded,
+                isExpandedMode ? 1.0f : 0.0f);
+
+            int numberOfChannels = channelSet.size();
+            KmeterAudioProcessorEditor editor(&processor, channelSet);
+
+            // meter readings are only fed to ballistics, so use an
+            // algorithm that does not need the average filter
+            auto meterBallistics = std::make_shared<MeterBallistics>(
+                                       numberOfChannels,
+                                       KmeterPluginParameters::selAlgorithmRms,
+                                       false,
+                                       false);
+
+            Array<float> peakLevels;
+            Array<float> averageLevels;
+            Array<int> overflowCounts;
+
+            for (int channel = 0; channel < numberOfChannels; ++channel)
+            {
+                peakLevels.add(0.0f);
+                averageLevels.add(MeterBallistics::getMeterMinimumDecibel());
+                overflowCounts.add(0);
+            }
+
+            int width = editor.getWidth();
+            int height = editor.getHeight();
+
+            Image frame(Image::RGB, width, height, true);
+            Image previousFrame(Image::RGB, width, height, true);
+
+            // use fixed seed so that all runs show identical traces
+            Random random(42);
+
+            int64 renderTicks = 0;
+            int64 changedPixels = 0;
+
+            for (int frameNumber = 0; frameNumber < numberOfFrames; ++frameNumber)
+            {
+                // level trace: slow envelope (different for each
+                // channel) plus some noise
+                for (int channel = 0; channel < numberOfChannels; ++channel)
+                {
+                    float envelope = 0.5f + 0.5f * std::sin(
+                                         0.05f * frameNumber + channel);
+                    float level = 0.7f * envelope * (0.8f + 0.2f * random.nextFloat());
+
+                    peakLevels.set(channel, level);
+                    averageLevels.set(channel, MeterBallistics::level2decibel(0.5f * level));
+                }
+
+                meterBallistics->updateChannels(framePeriod,
+                                                peakLevels.getRawDataPointer(),
+                                                peakLevels.getRawDataPointer(),
+                                                averageLevels.getRawDataPointer(),
+                                                overflowCounts.getRawDataPointer());
+
+                int64 startTicks = Time::getHighResolutionTicks();
+
+                editor.showLevels(meterBallistics);
+
+                {
+                    Graphics g(frame);
+                    editor.paintEntireComponent(g, false);
+                }
+
+                renderTicks += Time::getHighResolutionTicks() - startTicks;
+
+                // count pixels that differ from the previous frame
+                Image::BitmapData frameData(frame, Image::BitmapData::readOnly);
+                Image::BitmapData previousData(previousFrame, Image::BitmapData::readOnly);
+
+                for (int y = 0; y < height; ++y)
+                {
+                    const uint8 *line = frameData.getLinePointer(y);
+                    const uint8 *previousLine = previousData.getLinePointer(y);
+
+                    if (memcmp(line, previousLine, static_cast<size_t>(width * frameData.pixelStride)) == 0)
+                    {
+                        continue;
+                    }
+
+                    for (int x = 0; x < width; ++x)
+                    {
+                        int offset = x * frameData.pixelStride;
+
+                        if (memcmp(line + offset, previousLine + offset,
+                                   static_cast<size_t>(frameData.pixelStride)) != 0)
+                        {
+                            ++changedPixels;
+                        }
+                    }
+                }
+
+                previousFrame = frame.createCopy();
+            }
+
+            double milliSecondsPerFrame = 1e3 * Time::highResolutionTicksToSeconds(
+                                              renderTicks) / numberOfFrames;
+            double changedArea = 100.0 * changedPixels /
+                                 (static_cast<double>(width) * height * numberOfFrames);
+
+            print(
+                "  " +
+                channelSet.getDescription().paddedRight(' ', 12) +
+                (isDiscrete ? "discrete    " : "continuous  ") +
+                (isExpandedMode ? "expanded  " : "normal    ") +
+                String(width) + "x" + String(height) + "  " +
+                String(milliSecondsPerFrame, 3).paddedLeft(' ', 8) + " ms" +
+                String(changedArea, 1).paddedLeft(' ', 7) + " % changed");
+        }
+    }
+
+    print("");
+}
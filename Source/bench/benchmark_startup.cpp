@@ -0,0 +1,407 @@
+/* ----------------------------------------------------------------------------
+
+   K-Meter
+   =======
+   Implementation of a K-System meter according to Bob Katz' specifications
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "kmeter_bench.h"
+#include "../plugin_processor.h"
+
+
+// stages of instantiation and startup; the first four are timed in
+// isolation, the others as part of complete instances
+enum startupStage  // private namespace
+{
+    stageFftwTruePeak = 0,
+    stageFftwAverage,
+    stageSkinXml,
+    stageSkinImages,
+    stageConstructor,
+    stagePrepareToPlay,
+    stageCreateEditor,
+    stageSetStateInformation,
+
+    numberOfStartupStages
+};
+
+
+static const double startupSampleRate = 44100.0;
+static const int startupSamplesPerBlock = 512;
+
+
+static String getStartupStageName(const int stage)
+{
+    switch (stage)
+    {
+        case stageFftwTruePeak:
+            return "FFTW planning (true peak)";
+
+        case stageFftwAverage:
+            return "FFTW planning (average)";
+
+        case stageSkinXml:
+            return "skin XML parsing";
+
+        case stageSkinImages:
+            return "skin image decoding";
+
+        case stageConstructor:
+            return "constructor";
+
+        case stagePrepareToPlay:
+            return "prepareToPlay";
+
+        case stageCreateEditor:
+            return "createEditor (with skin)";
+
+        default:
+            return "setStateInformation";
+    }
+}
+
+
+/// Time FFTW planning, skin XML parsing and image decoding in
+/// isolation.
+///
+/// @param ticks receives high-resolution ticks spent in each stage
+///        (added to the existing values)
+///
+static void timeIsolatedStages(
+    int64 *ticks)
+{
+    File skinDirectory = KmeterPluginParameters::getSkinDirectory();
+    File skinFile = skinDirectory.getChildFile("Default.skin");
+
+    Array<File> imageFiles;
+    skinDirectory.findChildFiles(imageFiles, File::findFiles, true, "*.png");
+
+    int64 startTicks = Time::getHighResolutionTicks();
+
+    // FFTW planning (true peak meter)
+    {
+        frut::dsp::TruePeakMeter truePeakMeter(
+            KmeterPluginParameters::nNumChannels, 1024, 8);
+    }
+
+    ticks[stageFftwTruePeak] += Time::getHighResolutionTicks() - startTicks;
+    startTicks = Time::getHighResolutionTicks();
+
+    // FFTW planning and filter design (average filter)
+    {
+        AverageLevelFiltered averageLevelFiltered(
+            AudioChannelSet::canonicalChannelSet(KmeterPluginParameters::nNumChannels),
+            startupSampleRate, 1024,
+            KmeterPluginParameters::selAlgorithmItuBs1770);
+    }
+
+    ticks[stageFftwAverage] += Time::getHighResolutionTicks() - startTicks;
+    startTicks = Time::getHighResolutionTicks();
+
+    // skin XML parsing
+    {
+        std::unique_ptr<XmlElement> document = parseXML(skinFile);
+    }
+
+    ticks[stageSkinXml] += Time::getHighResolutionTicks() - startTicks;
+    startTicks = Time::getHighResolutionTicks();
+
+    // skin image decoding
+    for (const auto &imageFile : imageFiles)
+    {
+        Image image = ImageFileFormat::loadFrom(imageFile);
+    }
+
+    ticks[stageSkinImages] += Time::getHighResolutionTicks() - startTicks;
+}
+
+
+/// Create, prepare and open a complete plug-in instance and time each
+/// stage.
+///
+/// @param ticks receives high-resolution ticks spent in each stage
+///        (added to the existing values)
+///
+/// @param state plug-in state to restore; is filled from the first
+///        instance if empty
+///
+/// @param processors receives the new processor
+///
+/// @param editors receives the new editor
+///
+static void timeInstance(
+    int64 *ticks,
+    MemoryBlock &state,
+    OwnedArray<KmeterAudioProcessor> &processors,
+    OwnedArray<AudioProcessorEditor> &editors)
+{
+    int64 startTicks = Time::getHighResolutionTicks();
+
+    KmeterAudioProcessor *processor = processors.add(new KmeterAudioProcessor());
+
+    ticks[stageConstructor] += Time::getHighResolutionTicks() - startTicks;
+    startTicks = Time::getHighResolutionTicks();
+
+    processor->setRateAndBufferSizeDetails(startupSampleRate, startupSamplesPerBlock);
+    processor->prepareToPlay(startupSampleRate, startupSamplesPerBlock);
+
+    ticks[stagePrepareToPlay] += Time::getHighResolutionTicks() - startTicks;
+    startTicks = Time::getHighResolutionTicks();
+
+    editors.add(processor->createEditor());
+
+    ticks[stageCreateEditor] += Time::getHighResolutionTicks() - startTicks;
+
+    if (state.isEmpty())
+    {
+        processor->getStateInformation(state);
+    }
+
+    startTicks = Time::getHighResolutionTicks();
+
+    processor->setStateInformation(state.getData(),
+                                   static_cast<int>(state.getSize()));
+
+    ticks[stageSetStateInformation] += Time::getHighResolutionTicks() - startTicks;
+}
+
+
+/// Delete editors and processors created by "timeInstance".
+///
+/// @param processors processors to delete
+///
+/// @param editors editors to delete
+///
+static void deleteInstances(
+    OwnedArray<KmeterAudioProcessor> &processors,
+    OwnedArray<AudioProcessorEditor> &editors)
+{
+    // editors must be deleted before their processors
+    editors.clear();
+
+    for (auto processor : processors)
+    {
+        processor->releaseResources();
+    }
+
+    processors.clear();
+}
+
+
+/// Write result of a startup benchmark to the standard output.
+///
+/// @param name name of benchmarked stage
+///
+/// @param milliSeconds time spent in stage (in milliseconds)
+///
+void KmeterBenchmarks::reportStartupStage(
+    const String &name,
+    const double milliSeconds)
+{
+    print("  " +
+          name.paddedRight(' ', 28) +
+          String(milliSeconds, 3).paddedLeft(' ', 10) +
+          " ms");
+}
+
+
+/// Time a single cold run of either the isolated stages or a complete
+/// instance.  This is run in a child process of "benchmarkStartup",
+/// so nothing (FFTW plans, decoded images, fonts, ...) has been
+/// cached yet.  The results are written to the standard output in a
+/// format that is parsed by "benchmarkStartup".
+///
+/// @param timeInstances time a complete instance if true; otherwise,
+///        time the isolated stages
+///
+void KmeterBenchmarks::benchmarkStartupCold(
+    const bool timeInstances)
+{
+    int64 ticks[numberOfStartupStages] = {};
+
+    if (timeInstances)
+    {
+        MemoryBlock state;
+        OwnedArray<KmeterAudioProcessor> processors;
+        OwnedArray<AudioProcessorEditor> editors;
+
+        timeInstance(ticks, state, processors, editors);
+        deleteInstances(processors, editors);
+    }
+    else
+    {
+        timeIsolatedStages(ticks);
+    }
+
+    for (int stage = 0; stage < numberOfStartupStages; ++stage)
+    {
+        if (ticks[stage] > 0)
+        {
+            print("cold " + String(stage) + " " +
+                  String(Time::highResolutionTicksToSeconds(ticks[stage]), 9));
+        }
+    }
+}
+
+
+/// Benchmark instantiation and startup of the plug-in.  Cold costs of
+/// all stages are measured in fresh child processes.  Warm costs of
+/// FFTW planning, skin XML parsing and image decoding are measured in
+/// isolation, and those of the constructor, "prepareToPlay",
+/// "createEditor" (including skin load) and "setStateInformation"
+/// for 1, 10 and 100 instances that are alive at the same time.
+/// Must be called from the message thread.
+///
+void KmeterBenchmarks::benchmarkStartup()
+{
+    const int instanceCounts[] = {1, 10, 100};
+    const int numberOfRuns = 10;
+
+    // cold runs; isolated stages and complete instances use
+    // separate processes, as each would warm up the other
+    double coldSeconds[numberOfStartupStages] = {};
+    bool hasColdResults = true;
+
+    String executable = File::getSpecialLocation(
+                            File::currentExecutableFile).getFullPathName();
+
+    for (const auto &benchmark : {"startup-cold-stages", "startup-cold-instance"})
+    {
+        ChildProcess childProcess;
+        StringArray arguments;
+
+        arguments.add(executable);
+        arguments.add(benchmark);
+
+        if (!childProcess.start(arguments, ChildProcess::wantStdOut))
+        {
+            hasColdResults = false;
+            break;
+        }
+
+        StringArray lines;
+        lines.addLines(childProcess.readAllProcessOutput());
+
+        for (const auto &line : lines)
+        {
+            StringArray tokens;
+            tokens.addTokens(line, false);
+
+            if ((tokens.size() == 3) && (tokens[0] == "cold"))
+            {
+                int stage = tokens[1].getIntValue();
+
+                if (isPositiveAndBelow(stage, static_cast<int>(numberOfStartupStages)))
+                {
+                    coldSeconds[stage] = tokens[2].getDoubleValue();
+                }
+            }
+        }
+
+        if (childProcess.getExitCode() != 0)
+        {
+            hasColdResults = false;
+        }
+    }
+
+    print("startup, cold (fresh process)");
+
+    if (hasColdResults)
+    {
+        for (int stage = 0; stage < numberOfStartupStages; ++stage)
+        {
+            reportStartupStage(getStartupStageName(stage),
+                               1e3 * coldSeconds[stage]);
+        }
+    }
+    else
+    {
+        print("  could not start child process");
+    }
+
+    print("");
+
+    // isolated stages; the first run in this process is not timed
+    // because it is not warm
+    int64 ticks[numberOfStartupStages] = {};
+    timeIsolatedStages(ticks);
+
+    for (auto &stageTicks : ticks)
+    {
+        stageTicks = 0;
+    }
+
+    for (int run = 0; run < numberOfRuns; ++run)
+    {
+        timeIsolatedStages(ticks);
+    }
+
+    print("startup, warm (mean of " + String(numberOfRuns) + " runs)");
+
+    for (int stage = 0; stage < stageConstructor; ++stage)
+    {
+        reportStartupStage(getStartupStageName(stage),
+                           1e3 * Time::highResolutionTicksToSeconds(
+                               ticks[stage]) / numberOfRuns);
+    }
+
+    print("");
+
+    // complete instances; again, the first instance in this process
+    // is not timed
+    MemoryBlock state;
+
+    {
+        int64 warmUpTicks[numberOfStartupStages] = {};
+        OwnedArray<KmeterAudioProcessor> processors;
+        OwnedArray<AudioProcessorEditor> editors;
+
+        timeInstance(warmUpTicks, state, processors, editors);
+        deleteInstances(processors, editors);
+    }
+
+    for (int numberOfInstances : instanceCounts)
+    {
+        print("startup, " + String(numberOfInstances) +
+              " instance(s) (warm, mean per instance)");
+
+        int64 stageTicks[numberOfStartupStages] = {};
+        OwnedArray<KmeterAudioProcessor> processors;
+        OwnedArray<AudioProcessorEditor> editors;
+
+        // keep all instances alive, like a host loading a session
+        for (int instance = 0; instance < numberOfInstances; ++instance)
+        {
+            timeInstance(stageTicks, state, processors, editors);
+        }
+
+        for (int stage = stageConstructor; stage < numberOfStartupStages; ++stage)
+        {
+            reportStartupStage(getStartupStageName(stage),
+                               1e3 * Time::highResolutionTicksToSeconds(
+                                   stageTicks[stage]) / numberOfInstances);
+        }
+
+        print("");
+
+        deleteInstances(processors, editors);
+    }
+}
@@ -0,0 +1,125 @@
+/* ----------------------------------------------------------------------------
+
+   K-Meter
+   =======
+   Implementation of a K-System meter according to Bob Katz' specifications
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "kmeter_bench.h"
+
+#include <iostream>
+
+
+/// Write a line of benchmark results to the standard output.
+///
+/// @param line text to write
+///
+void KmeterBenchmarks::print(
+    const String &line)
+{
+    std::cout << line << std::endl;
+}
+
+
+static void printUsage(const String &applicationName)
+{
+    KmeterBenchmarks::print("Usage: " + applicationName + " [benchmark ...]");
+    KmeterBenchmarks::print("");
+    KmeterBenchmarks::print("Benchmarks (all of them are run if none is given):");
+    KmeterBenchmarks::print("  startup     instantiation and startup (cold and warm)");
+    KmeterBenchmarks::print("  dsp         DSP and audio building blocks in isolation");
+    KmeterBenchmarks::print("  processing  \"processBlock\" with a simulated host");
+    KmeterBenchmarks::print("  rendering   editor rendered into an offscreen image");
+}
+
+
+int main(int argc, char *argv[])
+{
+    // the message manager must exist before any processor is created
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    String applicationName = File::getSpecialLocation(
+                                 File::currentExecutableFile).getFileName();
+    StringArray benchmarks;
+
+    for (int argument = 1; argument < argc; ++argument)
+    {
+        benchmarks.add(argv[argument]);
+    }
+
+    // cold runs of the startup benchmark (started by the startup
+    // benchmark in a child process)
+    if (benchmarks[0] == "startup-cold-stages")
+    {
+        KmeterBenchmarks::benchmarkStartupCold(false);
+        return 0;
+    }
+    else if (benchmarks[0] == "startup-cold-instance")
+    {
+        KmeterBenchmarks::benchmarkStartupCold(true);
+        return 0;
+    }
+
+    StringArray knownBenchmarks;
+    knownBenchmarks.add("startup");
+    knownBenchmarks.add("dsp");
+    knownBenchmarks.add("processing");
+    knownBenchmarks.add("rendering");
+
+    if (benchmarks.isEmpty())
+    {
+        benchmarks = knownBenchmarks;
+    }
+
+    for (const auto &benchmark : benchmarks)
+    {
+        if (!knownBenchmarks.contains(benchmark))
+        {
+            printUsage(applicationName);
+            return 1;
+        }
+    }
+
+    // run first, so that the warm results are not affected by the
+    // other benchmarks
+    if (benchmarks.contains("startup"))
+    {
+        KmeterBenchmarks::benchmarkStartup();
+    }
+
+    if (benchmarks.contains("dsp"))
+    {
+        KmeterBenchmarks::benchmarkBuildingBlocks();
+        KmeterBenchmarks::benchmarkKWeighting();
+    }
+
+    if (benchmarks.contains("processing"))
+    {
+        KmeterBenchmarks::benchmarkProcessing();
+    }
+
+    if (benchmarks.contains("rendering"))
+    {
+        KmeterBenchmarks::benchmarkRendering();
+    }
+
+    return 0;
+}
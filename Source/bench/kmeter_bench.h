@@ -0,0 +1,60 @@
+/* ----------------------------------------------------------------------------
+
+   K-Meter
+   =======
+   Implementation of a K-System meter according to Bob Katz' specifications
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef KMETER_BENCH_KMETER_BENCH_H
+#define KMETER_BENCH_KMETER_BENCH_H
+
+#include "FrutHeader.h"
+
+
+/// Benchmarks for the "kmeter_bench" console application.  Results
+/// are written to the standard output.
+///
+class KmeterBenchmarks
+{
+public:
+    static void print(const String &line);
+
+    static void benchmarkBuildingBlocks();
+    static void benchmarkKWeighting();
+    static void benchmarkProcessing();
+    static void benchmarkStartup();
+    static void benchmarkStartupCold(const bool timeInstances);
+    static void benchmarkRendering();
+
+private:
+    JUCE_DECLARE_NON_COPYABLE(KmeterBenchmarks);
+
+    static void reportBuildingBlock(const String &name,
+                                    const int64 ticks,
+                                    const int numberOfSamples,
+                                    const int numberOfChannels,
+                                    const double sampleRate);
+
+    static void reportStartupStage(const String &name,
+                                   const double milliSeconds);
+};
+
+#endif  // KMETER_BENCH_KMETER_BENCH_H
@@ -0,0 +1,44 @@
+/* ----------------------------------------------------------------------------
+
+   K-Meter
+   =======
+   Implementation of a K-System meter according to Bob Katz' specifications
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef KMETER_EMBEDDED_SKIN_H
+#define KMETER_EMBEDDED_SKIN_H
+
+#include "FrutHeader.h"
+
+
+#if KMETER_EMBEDDED_SKIN
+
+// compiled default skin; the definitions are generated by the skin
+// compiler ("kmeter_skinc_* --embed")
+namespace KmeterEmbeddedSkin
+{
+extern const unsigned char bundleData[];
+extern const size_t bundleSize;
+}
+
+#endif  // KMETER_EMBEDDED_SKIN
+
+#endif  // KMETER_EMBEDDED_SKIN_H
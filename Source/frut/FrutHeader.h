@@ -33,6 +33,10 @@
 #define FRUT_DSP_USE_FFTW 0
 #endif
 
+#ifndef FRUT_AUDIO_USE_PROFILER
+#define FRUT_AUDIO_USE_PROFILER 0
+#endif
+
 
 namespace frut
 {
@@ -30,6 +30,9 @@
 #include "../FrutHeader.h"
 
 #include "../audio/buffer_position.cpp"
+#include "../audio/cpu_governor.cpp"
+#include "../audio/load_monitor.cpp"
+#include "../audio/profiler.cpp"
 #include "../audio/ring_buffer.cpp"
 
 
@@ -29,6 +29,9 @@
 
 // normal includes
 #include "../audio/buffer_position.h"
+#include "../audio/cpu_governor.h"
+#include "../audio/load_monitor.h"
+#include "../audio/profiler.h"
 #include "../audio/ring_buffer.h"
 
 
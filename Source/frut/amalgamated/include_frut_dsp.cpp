@@ -36,8 +36,10 @@
 #include "../dsp/filter_chebyshev_stage.cpp"
 #include "../dsp/fir_filter_box.cpp"
 #include "../dsp/iir_filter_box.cpp"
+#include "../dsp/interleaved_biquad_filter.cpp"
 #include "../dsp/rate_converter.cpp"
 #include "../dsp/true_peak_meter.cpp"
+#include "../dsp/true_peak_meter_parallel.cpp"
 
 
 #endif  // FRUT_AMALGAMATED_DSP_CPP
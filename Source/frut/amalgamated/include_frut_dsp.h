@@ -42,8 +42,10 @@
 #include "../dsp/filter_chebyshev_stage.h"
 #include "../dsp/fir_filter_box.h"
 #include "../dsp/iir_filter_box.h"
+#include "../dsp/interleaved_biquad_filter.h"
 #include "../dsp/rate_converter.h"
 #include "../dsp/true_peak_meter.h"
+#include "../dsp/true_peak_meter_parallel.h"
 
 // post includes
 #include "../dsp/filter_chebyshev.h"
@@ -29,8 +29,10 @@
 
 #include "../FrutHeader.h"
 
+#include "../skin/image_file_cache.cpp"
 #include "../skin/look_and_feel_v3.cpp"
 #include "../skin/skin.cpp"
+#include "../skin/skin_bundle.cpp"
 
 
 #endif  // FRUT_AMALGAMATED_SKIN_CPP
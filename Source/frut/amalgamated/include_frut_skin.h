@@ -28,7 +28,9 @@
 
 
 // normal includes
+#include "../skin/image_file_cache.h"
 #include "../skin/look_and_feel_v3.h"
+#include "../skin/skin_bundle.h"
 #include "../skin/skin.h"
 
 
@@ -41,6 +41,7 @@
 #include "../widgets/slider_continuous.cpp"
 #include "../widgets/slider_switch.cpp"
 #include "../widgets/slider_switch_linear_bar.cpp"
+#include "../widgets/snapshot_interpolator.cpp"
 #include "../widgets/state_label.cpp"
 #include "../widgets/window_about_content.cpp"
 #include "../widgets/window_settings_content.cpp"
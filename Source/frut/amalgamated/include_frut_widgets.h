@@ -43,6 +43,7 @@
 #include "../widgets/slider_continuous.h"
 #include "../widgets/slider_switch.h"
 #include "../widgets/slider_switch_linear_bar.h"
+#include "../widgets/snapshot_interpolator.h"
 #include "../widgets/state_label.h"
 #include "../widgets/window_about_content.h"
 #include "../widgets/window_settings_content.h"
@@ -0,0 +1,249 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+namespace frut
+{
+namespace audio
+{
+
+// registry of live instances (static storage is zero-initialised, so
+// all slots start out unused and without load)
+std::atomic<bool> CpuGovernor::slotIsUsed_[CpuGovernor::maximumInstances_];
+std::atomic<float> CpuGovernor::slotLoad_[CpuGovernor::maximumInstances_];
+
+// by default, all instances together may use up to 70 % of the
+// host's deadline
+std::atomic<float> CpuGovernor::budget_(0.7f);
+
+
+/// Create a new CPU governor and register it in the process-wide
+/// registry.  If the registry is full, the instance is not governed
+/// and never degrades.
+///
+CpuGovernor::CpuGovernor() :
+    // average processing load over quarter-second periods to smooth
+    // out chunk-sized spikes
+    measurementPeriod_(0.25),
+    // step back up when the total load falls below 60 % of the budget
+    headroomRatio_(0.6f),
+    // ... for a full second
+    headroomPeriodsUntilRestore_(4),
+    slot_(-1)
+{
+    for (int slot = 0; slot < maximumInstances_; ++slot)
+    {
+        bool isUsed = false;
+
+        if (slotIsUsed_[slot].compare_exchange_strong(isUsed, true))
+        {
+            slot_ = slot;
+            break;
+        }
+    }
+
+    reset();
+}
+
+
+/// Destructor.  Removes this instance from the process-wide registry.
+///
+CpuGovernor::~CpuGovernor()
+{
+    if (slot_ >= 0)
+    {
+        slotLoad_[slot_].store(0.0f);
+        slotIsUsed_[slot_].store(false);
+    }
+}
+
+
+/// Set maximum total load of all instances.
+///
+/// @param budget processing time as a fraction of the host's
+///        deadline (1.0 equals the full duration of an audio buffer)
+///
+void CpuGovernor::setBudget(
+    const float budget)
+{
+    jassert(budget > 0.0f);
+
+    budget_.store(budget);
+}
+
+
+/// Get maximum total load of all instances.
+///
+/// @return processing time as a fraction of the host's deadline
+///
+float CpuGovernor::getBudget()
+{
+    return budget_.load();
+}
+
+
+/// Get current total load of all instances.
+///
+/// @return processing time as a fraction of the host's deadline
+///
+float CpuGovernor::getTotalLoad()
+{
+    float totalLoad = 0.0f;
+
+    for (int slot = 0; slot < maximumInstances_; ++slot)
+    {
+        totalLoad += slotLoad_[slot].load(std::memory_order_relaxed);
+    }
+
+    return totalLoad;
+}
+
+
+/// Get number of registered instances.
+///
+/// @return number of instances
+///
+int CpuGovernor::getNumberOfInstances()
+{
+    int numberOfInstances = 0;
+
+    for (int slot = 0; slot < maximumInstances_; ++slot)
+    {
+        if (slotIsUsed_[slot].load(std::memory_order_relaxed))
+        {
+            ++numberOfInstances;
+        }
+    }
+
+    return numberOfInstances;
+}
+
+
+/// Forget all measurements of this instance and return to full
+/// processing.
+///
+void CpuGovernor::reset()
+{
+    processingSeconds_ = 0.0;
+    bufferSeconds_ = 0.0;
+    headroomPeriods_ = 0;
+
+    load_.store(0.0f);
+    isDegraded_.store(false);
+
+    if (slot_ >= 0)
+    {
+        slotLoad_[slot_].store(0.0f);
+    }
+}
+
+
+/// Add measured processing time of an audio buffer.  The load is
+/// published and the governor re-evaluated once per measurement
+/// period.  This function is real-time safe.
+///
+/// @param processingSeconds time spent processing the buffer
+///
+/// @param bufferSeconds duration of the buffer (host's deadline)
+///
+void CpuGovernor::addMeasurement(
+    const double processingSeconds,
+    const double bufferSeconds)
+{
+    processingSeconds_ += processingSeconds;
+    bufferSeconds_ += bufferSeconds;
+
+    if (bufferSeconds_ < measurementPeriod_)
+    {
+        return;
+    }
+
+    float load = static_cast<float>(processingSeconds_ / bufferSeconds_);
+
+    processingSeconds_ = 0.0;
+    bufferSeconds_ = 0.0;
+
+    load_.store(load, std::memory_order_relaxed);
+
+    // registry is full, so this instance is not governed
+    if (slot_ < 0)
+    {
+        return;
+    }
+
+    slotLoad_[slot_].store(load, std::memory_order_relaxed);
+
+    float totalLoad = getTotalLoad();
+    float budget = budget_.load(std::memory_order_relaxed);
+
+    if (!isDegraded_.load(std::memory_order_relaxed))
+    {
+        if (totalLoad > budget)
+        {
+            isDegraded_.store(true, std::memory_order_relaxed);
+            headroomPeriods_ = 0;
+        }
+    }
+    // stepping down lowers the total load, so require a margin
+    // (and some patience) before stepping back up to prevent
+    // oscillations
+    else if (totalLoad < budget * headroomRatio_)
+    {
+        ++headroomPeriods_;
+
+        if (headroomPeriods_ >= headroomPeriodsUntilRestore_)
+        {
+            isDegraded_.store(false, std::memory_order_relaxed);
+            headroomPeriods_ = 0;
+        }
+    }
+    else
+    {
+        headroomPeriods_ = 0;
+    }
+}
+
+
+/// Get load of this instance, averaged over the last measurement
+/// period.
+///
+/// @return processing time as a fraction of the host's deadline
+///
+float CpuGovernor::getLoad() const
+{
+    return load_.load(std::memory_order_relaxed);
+}
+
+
+/// Check whether optional processing stages should be stepped down.
+///
+/// @return true if the total load has exceeded the budget
+///
+bool CpuGovernor::isDegraded() const
+{
+    return isDegraded_.load(std::memory_order_relaxed);
+}
+
+}
+}
@@ -0,0 +1,90 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef FRUT_AUDIO_CPU_GOVERNOR_H
+#define FRUT_AUDIO_CPU_GOVERNOR_H
+
+namespace frut
+{
+namespace audio
+{
+
+/// Process-wide CPU budget for all instances of a plug-in.  Every
+/// instance measures how long it takes to process an audio buffer
+/// and compares this to the buffer's duration (the host's deadline).
+/// When the summed load of all live instances exceeds the budget,
+/// all governed instances are asked to step down optional processing
+/// stages; they step back up once enough headroom has returned.
+///
+/// The registry of instances is lock-free, so measurements may be
+/// added from the audio thread.
+///
+class CpuGovernor
+{
+public:
+    CpuGovernor();
+    ~CpuGovernor();
+
+    static void setBudget(const float budget);
+    static float getBudget();
+
+    static float getTotalLoad();
+    static int getNumberOfInstances();
+
+    void reset();
+
+    void addMeasurement(const double processingSeconds,
+                        const double bufferSeconds);
+
+    float getLoad() const;
+    bool isDegraded() const;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CpuGovernor);
+
+    static const int maximumInstances_ = 128;
+
+    static std::atomic<bool> slotIsUsed_[maximumInstances_];
+    static std::atomic<float> slotLoad_[maximumInstances_];
+    static std::atomic<float> budget_;
+
+    const double measurementPeriod_;
+    const float headroomRatio_;
+    const int headroomPeriodsUntilRestore_;
+
+    int slot_;
+
+    double processingSeconds_;
+    double bufferSeconds_;
+    int headroomPeriods_;
+
+    std::atomic<float> load_;
+    std::atomic<bool> isDegraded_;
+};
+
+}
+}
+
+#endif  // FRUT_AUDIO_CPU_GOVERNOR_H
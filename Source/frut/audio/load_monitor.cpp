@@ -0,0 +1,189 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+namespace frut
+{
+namespace audio
+{
+
+// C++14 still needs a definition for ODR-used static constexpr members
+constexpr float LoadMonitor::binsPerLoad_;
+
+
+/// Create a new load monitor.
+///
+LoadMonitor::LoadMonitor() :
+    loadSum_(0),
+    deadlineMisses_(0),
+    // report callbacks that use more than half of the deadline
+    deadlineFraction_(0.5f),
+    previousLoadSum_(0)
+{
+    for (int bin = 0; bin < numberOfBins_; ++bin)
+    {
+        histogram_[bin].store(0);
+        previousHistogram_[bin] = 0;
+    }
+}
+
+
+/// Set the fraction of the host's deadline above which a callback
+/// counts as a deadline miss.
+///
+/// @param deadlineFraction fraction of the deadline (1.0 equals the
+///        full duration of an audio buffer)
+///
+void LoadMonitor::setDeadlineFraction(
+    const float deadlineFraction)
+{
+    jassert(deadlineFraction > 0.0f);
+
+    deadlineFraction_.store(deadlineFraction);
+}
+
+
+/// Get the fraction of the host's deadline above which a callback
+/// counts as a deadline miss.
+///
+/// @return fraction of the deadline
+///
+float LoadMonitor::getDeadlineFraction() const
+{
+    return deadlineFraction_.load();
+}
+
+
+/// Add measured processing time of an audio buffer.  This function
+/// is real-time safe and must only be called from a single thread.
+///
+/// @param processingSeconds time spent processing the buffer
+///
+/// @param bufferSeconds duration of the buffer (host's deadline)
+///
+void LoadMonitor::addMeasurement(
+    const double processingSeconds,
+    const double bufferSeconds)
+{
+    if (bufferSeconds <= 0.0)
+    {
+        return;
+    }
+
+    float load = static_cast<float>(processingSeconds / bufferSeconds);
+    int bin = jmin(static_cast<int>(load * binsPerLoad_),
+                   numberOfBins_ - 1);
+
+    // single writer, so plain loads and stores suffice (no
+    // read-modify-write operations needed)
+    histogram_[bin].store(
+        histogram_[bin].load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+
+    // sum of loads in parts per million
+    loadSum_.store(
+        loadSum_.load(std::memory_order_relaxed) +
+        static_cast<uint64>(load * 1e6f),
+        std::memory_order_relaxed);
+
+    if (load > deadlineFraction_.load(std::memory_order_relaxed))
+    {
+        deadlineMisses_.store(
+            deadlineMisses_.load(std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed);
+    }
+}
+
+
+/// Get load statistics for the period since this function was last
+/// called.  Must only be called from a single (GUI) thread.
+///
+/// @return load statistics (deadline misses are counted from
+///         creation of this monitor)
+///
+LoadMonitor::Statistics LoadMonitor::getStatistics()
+{
+    Statistics statistics;
+    uint32 binCounts[numberOfBins_];
+
+    statistics.numberOfCallbacks = 0;
+    statistics.deadlineMisses = deadlineMisses_.load(
+                                    std::memory_order_relaxed);
+
+    for (int bin = 0; bin < numberOfBins_; ++bin)
+    {
+        uint32 count = histogram_[bin].load(std::memory_order_relaxed);
+
+        // unsigned arithmetic handles wrap-around of counters
+        binCounts[bin] = count - previousHistogram_[bin];
+        previousHistogram_[bin] = count;
+
+        statistics.numberOfCallbacks += binCounts[bin];
+    }
+
+    uint64 loadSum = loadSum_.load(std::memory_order_relaxed);
+    uint64 periodLoadSum = loadSum - previousLoadSum_;
+    previousLoadSum_ = loadSum;
+
+    statistics.averageLoad = 0.0f;
+    statistics.percentileLoad = 0.0f;
+    statistics.maximumLoad = 0.0f;
+
+    if (statistics.numberOfCallbacks == 0)
+    {
+        return statistics;
+    }
+
+    statistics.averageLoad = static_cast<float>(periodLoadSum) /
+                             (1e6f * statistics.numberOfCallbacks);
+
+    // report upper edge of bins so that loads are never understated
+    uint32 percentileRank = (statistics.numberOfCallbacks * 99 + 99) / 100;
+    uint32 cumulatedCount = 0;
+    bool percentileFound = false;
+
+    for (int bin = 0; bin < numberOfBins_; ++bin)
+    {
+        if (binCounts[bin] == 0)
+        {
+            continue;
+        }
+
+        cumulatedCount += binCounts[bin];
+        float upperEdge = (bin + 1) / binsPerLoad_;
+
+        if (!percentileFound && (cumulatedCount >= percentileRank))
+        {
+            statistics.percentileLoad = upperEdge;
+            percentileFound = true;
+        }
+
+        statistics.maximumLoad = upperEdge;
+    }
+
+    return statistics;
+}
+
+}
+}
@@ -0,0 +1,88 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef FRUT_AUDIO_LOAD_MONITOR_H
+#define FRUT_AUDIO_LOAD_MONITOR_H
+
+namespace frut
+{
+namespace audio
+{
+
+/// Monitors processing time as a fraction of the host's deadline
+/// (the duration of an audio buffer).  The audio thread only ever
+/// stores to atomics, and the GUI thread derives average, 99th
+/// percentile and maximum load for the period since it last asked.
+///
+class LoadMonitor
+{
+public:
+    /// Load statistics for a period of time.  All loads are given as
+    /// fractions of the host's deadline.
+    ///
+    struct Statistics
+    {
+        float averageLoad;
+        float percentileLoad;
+        float maximumLoad;
+
+        uint32 numberOfCallbacks;
+        uint32 deadlineMisses;
+    };
+
+    LoadMonitor();
+
+    void setDeadlineFraction(const float deadlineFraction);
+    float getDeadlineFraction() const;
+
+    void addMeasurement(const double processingSeconds,
+                        const double bufferSeconds);
+
+    Statistics getStatistics();
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoadMonitor);
+
+    // loads from 0 % to 200 % in steps of 0.5 %; the last bin also
+    // collects all higher loads
+    static const int numberOfBins_ = 401;
+    static constexpr float binsPerLoad_ = 200.0f;
+
+    // audio thread (single writer)
+    std::atomic<uint32> histogram_[numberOfBins_];
+    std::atomic<uint64> loadSum_;
+    std::atomic<uint32> deadlineMisses_;
+
+    std::atomic<float> deadlineFraction_;
+
+    // GUI thread
+    uint32 previousHistogram_[numberOfBins_];
+    uint64 previousLoadSum_;
+};
+
+}
+}
+
+#endif  // FRUT_AUDIO_LOAD_MONITOR_H
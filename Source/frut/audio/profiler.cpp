@@ -0,0 +1,287 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#if FRUT_AUDIO_USE_PROFILER
+
+namespace frut
+{
+namespace audio
+{
+
+// static storage is zero-initialised, so all slots start out unused
+// and empty; memory pages are only touched once a thread records
+std::atomic<bool> Profiler::slotIsUsed_[Profiler::maximumThreads_];
+Profiler::ThreadEvents Profiler::threadEvents_[Profiler::maximumThreads_];
+std::atomic<uint32> Profiler::nextThreadId_(1);
+
+thread_local const void *Profiler::currentInstance_ = nullptr;
+
+
+/// Start recording an event.
+///
+/// @param name name of the event (must point to a string literal)
+///
+Profiler::ScopedEvent::ScopedEvent(
+    const char *name) :
+
+    name_(name),
+    startTicks_(Time::getHighResolutionTicks())
+{
+}
+
+
+/// Stop recording the event and store it.
+///
+Profiler::ScopedEvent::~ScopedEvent()
+{
+    Profiler::addEvent(name_, startTicks_,
+                       Time::getHighResolutionTicks());
+}
+
+
+/// Attribute events of the calling thread to a plug-in instance
+/// until destruction.
+///
+/// @param instance plug-in instance (usually its audio processor)
+///
+Profiler::ScopedInstance::ScopedInstance(
+    const void *instance) :
+
+    previousInstance_(currentInstance_)
+{
+    currentInstance_ = instance;
+}
+
+
+/// Restore the previous instance of the calling thread.
+///
+Profiler::ScopedInstance::~ScopedInstance()
+{
+    currentInstance_ = previousInstance_;
+}
+
+
+/// Get plug-in instance that the calling thread records events for.
+///
+/// @return plug-in instance or **nullptr** if none has been set
+///
+const void *Profiler::getCurrentInstance()
+{
+    return currentInstance_;
+}
+
+
+/// Claim a free ring buffer without locking.  Events of the ring
+/// buffer's previous owner are kept until they are overwritten.
+///
+Profiler::ThreadSlot::ThreadSlot() :
+    threadEvents(nullptr),
+    threadId(0),
+    slot_(-1)
+{
+    for (int slot = 0; slot < maximumThreads_; ++slot)
+    {
+        bool isUsed = false;
+
+        if (slotIsUsed_[slot].compare_exchange_strong(isUsed, true))
+        {
+            slot_ = slot;
+            threadEvents = &threadEvents_[slot];
+            threadId = nextThreadId_.fetch_add(1);
+
+            break;
+        }
+    }
+}
+
+
+/// Release ring buffer when the thread exits, so that it can be
+/// claimed by threads that are started later on.
+///
+Profiler::ThreadSlot::~ThreadSlot()
+{
+    if (slot_ >= 0)
+    {
+        slotIsUsed_[slot_].store(false);
+    }
+}
+
+
+/// Get ring buffer of the calling thread.  On first use, a free ring
+/// buffer is claimed.
+///
+/// @return slot of the calling thread; its ring buffer is
+///         **nullptr** if all ring buffers are in use
+///
+Profiler::ThreadSlot &Profiler::getThreadSlot()
+{
+    thread_local ThreadSlot threadSlot;
+
+    return threadSlot;
+}
+
+
+/// Store an event in the calling thread's ring buffer.  Once the ring
+/// buffer is full, the oldest events are overwritten.  Events are
+/// dropped when more threads record at the same time than there are
+/// ring buffers.
+///
+/// @param name name of the event (must point to a string literal)
+///
+/// @param startTicks high-resolution ticks at start of event
+///
+/// @param endTicks high-resolution ticks at end of event
+///
+void Profiler::addEvent(
+    const char *name,
+    const int64 startTicks,
+    const int64 endTicks)
+{
+    ThreadSlot &threadSlot = getThreadSlot();
+    ThreadEvents *threadEvents = threadSlot.threadEvents;
+
+    if (threadEvents == nullptr)
+    {
+        return;
+    }
+
+    uint32 eventIndex = threadEvents->numberOfEvents.load(
+                            std::memory_order_relaxed);
+    Event &event = threadEvents->events[eventIndex % maximumEvents_];
+
+    event.name = name;
+    event.instance = currentInstance_;
+    event.threadId = threadSlot.threadId;
+    event.startTicks = startTicks;
+    event.endTicks = endTicks;
+
+    threadEvents->numberOfEvents.store(eventIndex + 1,
+                                       std::memory_order_release);
+}
+
+
+/// Export recorded events of all threads in Chrome's "trace_event"
+/// format.  Every plug-in instance is exported as a process, and
+/// events recorded outside of any instance go to process 0.  Events
+/// that are overwritten while exporting may appear garbled, so
+/// preferably export while no audio is processed.
+///
+/// @return JSON string
+///
+String Profiler::getChromeTrace()
+{
+    String trace = "{\"traceEvents\":[\n";
+    bool isFirstEvent = true;
+
+    // number instances in order of appearance
+    Array<const void *> instances;
+
+    for (int slot = 0; slot < maximumThreads_; ++slot)
+    {
+        const ThreadEvents &threadEvents = threadEvents_[slot];
+        uint32 numberOfEvents = threadEvents.numberOfEvents.load(
+                                    std::memory_order_acquire);
+        uint32 firstEvent = 0;
+
+        if (numberOfEvents > maximumEvents_)
+        {
+            firstEvent = numberOfEvents - maximumEvents_;
+        }
+
+        for (uint32 eventIndex = firstEvent; eventIndex < numberOfEvents; ++eventIndex)
+        {
+            const Event &event = threadEvents.events[eventIndex % maximumEvents_];
+
+            int processId = 0;
+
+            if (event.instance != nullptr)
+            {
+                instances.addIfNotAlreadyThere(event.instance);
+                processId = instances.indexOf(event.instance) + 1;
+            }
+
+            // Chrome expects microseconds
+            double start = Time::highResolutionTicksToSeconds(
+                               event.startTicks) * 1e6;
+            double duration = Time::highResolutionTicksToSeconds(
+                                  event.endTicks - event.startTicks) * 1e6;
+
+            if (!isFirstEvent)
+            {
+                trace += ",\n";
+            }
+
+            trace += "{\"name\":\"" + String(event.name) +
+                     "\",\"ph\":\"X\",\"pid\":" + String(processId) +
+                     ",\"tid\":" + String(event.threadId) +
+                     ",\"ts\":" + String(start, 3) +
+                     ",\"dur\":" + String(duration, 3) + "}";
+
+            isFirstEvent = false;
+        }
+    }
+
+    // name processes after plug-in instances
+    for (int processId = 0; processId <= instances.size(); ++processId)
+    {
+        String processName = (processId == 0) ?
+                             "no instance" :
+                             "instance " + String(processId);
+
+        if (!isFirstEvent)
+        {
+            trace += ",\n";
+        }
+
+        trace += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" +
+                 String(processId) + ",\"args\":{\"name\":\"" +
+                 processName + "\"}}";
+
+        isFirstEvent = false;
+    }
+
+    trace += "\n]}\n";
+
+    return trace;
+}
+
+
+/// Export recorded events of all threads to a file in Chrome's
+/// "trace_event" format.
+///
+/// @param traceFile output file (will be overwritten)
+///
+/// @return true on success
+///
+bool Profiler::writeChromeTrace(
+    const File &traceFile)
+{
+    return traceFile.replaceWithText(getChromeTrace());
+}
+
+}
+}
+
+#endif  // FRUT_AUDIO_USE_PROFILER
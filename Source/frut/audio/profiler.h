@@ -0,0 +1,154 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef FRUT_AUDIO_PROFILER_H
+#define FRUT_AUDIO_PROFILER_H
+
+#if FRUT_AUDIO_USE_PROFILER
+
+namespace frut
+{
+namespace audio
+{
+
+/// Lock-free profiler for processing stages.  Every thread records
+/// its events into a ring buffer of its own, so recording never
+/// blocks or allocates memory.  Ring buffers are released when their
+/// thread exits; their events are kept until the ring buffer's next
+/// owner overwrites them.  The collected events can be exported in
+/// Chrome's "trace_event" format (load the file in Perfetto or
+/// chrome://tracing), where every plug-in instance is shown as a
+/// process of its own.
+///
+/// The profiler is only compiled if FRUT_AUDIO_USE_PROFILER is set
+/// to 1; otherwise, FRUT_PROFILE_SCOPE and FRUT_PROFILE_INSTANCE
+/// expand to nothing.
+///
+class Profiler
+{
+public:
+    /// Records the time between its construction and destruction as
+    /// a single event.
+    ///
+    class ScopedEvent
+    {
+    public:
+        explicit ScopedEvent(const char *name);
+        ~ScopedEvent();
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE(ScopedEvent);
+
+        const char *name_;
+        int64 startTicks_;
+    };
+
+    /// Attributes all events that the calling thread records during
+    /// its lifetime to a plug-in instance.
+    ///
+    class ScopedInstance
+    {
+    public:
+        explicit ScopedInstance(const void *instance);
+        ~ScopedInstance();
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE(ScopedInstance);
+
+        const void *previousInstance_;
+    };
+
+    static const void *getCurrentInstance();
+
+    static void addEvent(const char *name,
+                         const int64 startTicks,
+                         const int64 endTicks);
+
+    static String getChromeTrace();
+    static bool writeChromeTrace(const File &traceFile);
+
+private:
+    static const int maximumThreads_ = 16;
+    static const uint32 maximumEvents_ = 8192;
+
+    struct Event
+    {
+        const char *name;
+        const void *instance;
+        uint32 threadId;
+        int64 startTicks;
+        int64 endTicks;
+    };
+
+    struct ThreadEvents
+    {
+        std::atomic<uint32> numberOfEvents;
+        Event events[maximumEvents_];
+    };
+
+    /// Claims a ring buffer for the calling thread and releases it
+    /// when the thread exits.
+    ///
+    class ThreadSlot
+    {
+    public:
+        ThreadSlot();
+        ~ThreadSlot();
+
+        ThreadEvents *threadEvents;
+        uint32 threadId;
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE(ThreadSlot);
+
+        int slot_;
+    };
+
+    static ThreadSlot &getThreadSlot();
+
+    static std::atomic<bool> slotIsUsed_[maximumThreads_];
+    static ThreadEvents threadEvents_[maximumThreads_];
+    static std::atomic<uint32> nextThreadId_;
+
+    static thread_local const void *currentInstance_;
+};
+
+}
+}
+
+#define FRUT_PROFILE_SCOPE(name) \
+    frut::audio::Profiler::ScopedEvent JUCE_JOIN_MACRO(frutProfilerEvent_, __LINE__)(name)
+
+#define FRUT_PROFILE_INSTANCE(instance) \
+    frut::audio::Profiler::ScopedInstance JUCE_JOIN_MACRO(frutProfilerInstance_, __LINE__)(instance)
+
+#else
+
+#define FRUT_PROFILE_SCOPE(name)
+#define FRUT_PROFILE_INSTANCE(instance)
+
+#endif  // FRUT_AUDIO_USE_PROFILER
+
+#endif  // FRUT_AUDIO_PROFILER_H
@@ -67,6 +67,10 @@ RingBuffer<Type>::RingBuffer(
     chunkSize_ = chunkSize;
     this->setCallbackClass(nullptr);
 
+    // the callback receives its chunk in this buffer, so allocate it
+    // here instead of on the audio thread
+    chunkBuffer_.setSize(numberOfChannels_, chunkSize_);
+
     // allocate memory for samples and pad memory areas to allow the
     // detection of memory leaks
     int paddedTotalLength = totalLength + 2;
@@ -309,16 +313,14 @@ void RingBuffer<Type>::importFrom(
             // run callback (if any)
             if (callbackClass_)
             {
-                AudioBuffer<Type> buffer(numberOfChannels_, chunkSize_);
-
-                copyTo(buffer, 0, chunkSize_);
+                copyTo(chunkBuffer_, 0, chunkSize_);
 
                 // process buffer chunk
-                bool writeBack = callbackClass_->processBufferChunk(buffer);
+                bool writeBack = callbackClass_->processBufferChunk(chunkBuffer_);
 
                 if (writeBack)
                 {
-                    overwriteFrom(buffer, 0, chunkSize_);
+                    overwriteFrom(chunkBuffer_, 0, chunkSize_);
                 }
             }
         }
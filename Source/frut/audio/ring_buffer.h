@@ -169,6 +169,7 @@ protected:
 
     Array<int> channelOffsets_;
     HeapBlock<Type> audioData_;
+    AudioBuffer<Type> chunkBuffer_;
 
     int numberOfChannels_;
     int chunkSize_;
@@ -30,7 +30,8 @@ namespace dsp
 
 Dither::Dither() :
     antiDenormalFloat_(FLT_MIN),
-    antiDenormalDouble_(DBL_MIN)
+    antiDenormalDouble_(DBL_MIN),
+    randomMaximum_(0x7fffffff)
 {
     numberOfChannels_ = -1;
 
@@ -81,7 +82,7 @@ void Dither::initialise(
     wordLengthInverted_ = 1.0 / wordLength_;
 
     // dither amplitude (2 LSB)
-    ditherAmplitude_ = wordLengthInverted_ / RAND_MAX;
+    ditherAmplitude_ = wordLengthInverted_ / randomMaximum_;
 
     // remove DC offset
     dcOffset_ = wordLengthInverted_ * 0.5;
@@ -252,11 +253,13 @@ float Dither::ditherSample(
 {
     jassert(isInitialized_);
 
-    // can make HP-TRI dither by subtracting previous rand()
+    // can make HP-TRI dither by subtracting previous random number;
+    // unlike rand(), this generator is not shared between threads
+    // and thus never takes a lock
     randomNumber_2_.set(currentChannel,
                         randomNumber_1_[currentChannel]);
     randomNumber_1_.set(currentChannel,
-                        rand());
+                        random_.nextInt() & randomMaximum_);
 
     // error feedback
     double destinationValue = sourceValueDouble + noiseShaping_ *
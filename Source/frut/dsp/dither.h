@@ -68,6 +68,9 @@ private:
     const float antiDenormalFloat_;
     const double antiDenormalDouble_;
 
+    Random random_;
+    const int randomMaximum_;
+
     bool isInitialized_;
 
     int numberOfChannels_;
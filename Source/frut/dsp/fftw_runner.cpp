@@ -145,6 +145,8 @@ void FftwRunner::convolveWithKernel(
     const float oversamplingRate)
 
 {
+    FRUT_PROFILE_SCOPE("FftwRunner::convolveWithKernel");
+
     jassert(channel >= 0);
     jassert(channel < numberOfChannels_);
 
@@ -0,0 +1,224 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+namespace frut
+{
+namespace dsp
+{
+
+/// Create a new cascade of interleaved biquad filters.  All stages
+/// start out neutral.
+///
+/// @param numberOfChannels number of audio channels
+///
+/// @param numberOfStages number of cascaded biquad filters
+///
+/// @param maximumNumberOfSamples maximum number of samples that will
+///        be processed in one go
+///
+InterleavedBiquadFilter::InterleavedBiquadFilter(
+    const int numberOfChannels,
+    const int numberOfStages,
+    const int maximumNumberOfSamples) :
+
+    numberOfChannels_(numberOfChannels),
+    numberOfStages_(numberOfStages),
+    numberOfGroups_((numberOfChannels + laneCount - 1) / laneCount),
+    maximumNumberOfSamples_(maximumNumberOfSamples)
+{
+    jassert(numberOfChannels_ > 0);
+    jassert(numberOfStages_ > 0);
+    jassert(maximumNumberOfSamples_ > 0);
+
+    for (int stage = 0; stage < numberOfStages_; ++stage)
+    {
+        coefficients_.add(1.0);
+        coefficients_.add(0.0);
+        coefficients_.add(0.0);
+
+        coefficients_.add(0.0);
+        coefficients_.add(0.0);
+    }
+
+    delays_.calloc(numberOfGroups_ * numberOfStages_ * 2 * laneCount);
+    interleavedSamples_.calloc(maximumNumberOfSamples_ * laneCount);
+}
+
+
+/// Reset filter storage.
+///
+void InterleavedBiquadFilter::resetDelays()
+{
+    delays_.clear(numberOfGroups_ * numberOfStages_ * 2 * laneCount);
+}
+
+
+/// Set coefficients of a filter stage.  Every filter stage calculates
+/// y[n] = a0 * x[n] + a1 * x[n-1] + a2 * x[n-2] - b1 * y[n-1] - b2 *
+/// y[n-2] (just like BiquadFilter).
+///
+/// @param stage filter stage
+///
+void InterleavedBiquadFilter::setCoefficients(
+    const int stage,
+
+    const double a0,
+    const double a1,
+    const double a2,
+
+    const double b1,
+    const double b2)
+{
+    jassert(isPositiveAndBelow(stage, numberOfStages_));
+
+    int index = stage * 5;
+
+    coefficients_.set(index + 0, a0);
+    coefficients_.set(index + 1, a1);
+    coefficients_.set(index + 2, a2);
+
+    coefficients_.set(index + 3, b1);
+    coefficients_.set(index + 4, b2);
+}
+
+
+/// Filter audio samples.  Input and output buffer may be the same.
+///
+/// @param inputBuffer buffer to read samples from
+///
+/// @param outputBuffer buffer to write filtered samples to
+///
+/// @param numberOfSamples number of samples to process, starting from
+///        the **beginning** of the buffers
+///
+void InterleavedBiquadFilter::process(
+    const AudioBuffer<float> &inputBuffer,
+    AudioBuffer<float> &outputBuffer,
+    const int numberOfSamples)
+{
+    jassert(inputBuffer.getNumChannels() == numberOfChannels_);
+    jassert(outputBuffer.getNumChannels() == numberOfChannels_);
+    jassert(isPositiveAndNotGreaterThan(numberOfSamples,
+                                        maximumNumberOfSamples_));
+
+    double *samples = interleavedSamples_.get();
+
+    for (int group = 0; group < numberOfGroups_; ++group)
+    {
+        int firstChannel = group * laneCount;
+        int usedLanes = jmin(laneCount, numberOfChannels_ - firstChannel);
+
+        // interleave samples; unused lanes are kept at zero
+        for (int lane = 0; lane < laneCount; ++lane)
+        {
+            if (lane < usedLanes)
+            {
+                const float *input = inputBuffer.getReadPointer(
+                                         firstChannel + lane);
+
+                for (int sample = 0; sample < numberOfSamples; ++sample)
+                {
+                    samples[sample * laneCount + lane] = input[sample];
+                }
+            }
+            else
+            {
+                for (int sample = 0; sample < numberOfSamples; ++sample)
+                {
+                    samples[sample * laneCount + lane] = 0.0;
+                }
+            }
+        }
+
+        for (int stage = 0; stage < numberOfStages_; ++stage)
+        {
+            const double *coefficients = coefficients_.getRawDataPointer() +
+                                         stage * 5;
+
+            const double a0 = coefficients[0];
+            const double a1 = coefficients[1];
+            const double a2 = coefficients[2];
+
+            const double b1 = coefficients[3];
+            const double b2 = coefficients[4];
+
+            double *delays = delays_.get() +
+                             ((group * numberOfStages_) + stage) * 2 * laneCount;
+
+            // keep delays in local arrays so the compiler can hold
+            // them in registers
+            double delay_1[laneCount];
+            double delay_2[laneCount];
+
+            for (int lane = 0; lane < laneCount; ++lane)
+            {
+                delay_1[lane] = delays[lane];
+                delay_2[lane] = delays[laneCount + lane];
+            }
+
+            for (int sample = 0; sample < numberOfSamples; ++sample)
+            {
+                double *frame = samples + sample * laneCount;
+
+                // no dependencies between lanes, so this loop can be
+                // vectorised
+                for (int lane = 0; lane < laneCount; ++lane)
+                {
+                    double input = frame[lane];
+                    double output = a0 * input + delay_1[lane];
+
+                    delay_1[lane] = a1 * input - b1 * output + delay_2[lane];
+                    delay_2[lane] = a2 * input - b2 * output;
+
+                    frame[lane] = output;
+                }
+            }
+
+            // avoid underflows (1e-20 corresponds to -400 dBFS)
+            for (int lane = 0; lane < laneCount; ++lane)
+            {
+                delays[lane] = (fabs(delay_1[lane]) < 1e-20) ?
+                               0.0 : delay_1[lane];
+                delays[laneCount + lane] = (fabs(delay_2[lane]) < 1e-20) ?
+                                           0.0 : delay_2[lane];
+            }
+        }
+
+        // de-interleave samples
+        for (int lane = 0; lane < usedLanes; ++lane)
+        {
+            float *output = outputBuffer.getWritePointer(firstChannel + lane);
+
+            for (int sample = 0; sample < numberOfSamples; ++sample)
+            {
+                output[sample] = static_cast<float>(
+                                     samples[sample * laneCount + lane]);
+            }
+        }
+    }
+}
+
+}
+}
@@ -0,0 +1,80 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef FRUT_DSP_INTERLEAVED_BIQUAD_FILTER_H
+#define FRUT_DSP_INTERLEAVED_BIQUAD_FILTER_H
+
+namespace frut
+{
+namespace dsp
+{
+
+/// Cascade of biquad filters that processes several audio channels at
+/// once.  Channels are grouped into blocks of "laneCount" channels
+/// and their samples are interleaved, so that every channel occupies
+/// one SIMD lane.  The filter recursion only runs along time, which
+/// allows the compiler to vectorise the loop over the lanes.
+///
+class InterleavedBiquadFilter
+{
+public:
+    static const int laneCount = 4;
+
+    InterleavedBiquadFilter(const int numberOfChannels,
+                            const int numberOfStages,
+                            const int maximumNumberOfSamples);
+
+    void resetDelays();
+
+    void setCoefficients(const int stage,
+                         const double a0, const double a1, const double a2,
+                         const double b1, const double b2);
+
+    void process(const AudioBuffer<float> &inputBuffer,
+                 AudioBuffer<float> &outputBuffer,
+                 const int numberOfSamples);
+
+private:
+    JUCE_LEAK_DETECTOR(InterleavedBiquadFilter);
+
+    int numberOfChannels_;
+    int numberOfStages_;
+    int numberOfGroups_;
+    int maximumNumberOfSamples_;
+
+    // five coefficients per stage (a0, a1, a2, b1, b2)
+    Array<double> coefficients_;
+
+    // two delays per stage and lane (transposed direct form II)
+    HeapBlock<double> delays_;
+
+    // samples of one group of channels, interleaved by lane
+    HeapBlock<double> interleavedSamples_;
+};
+
+}
+}
+
+#endif  // FRUT_DSP_INTERLEAVED_BIQUAD_FILTER_H
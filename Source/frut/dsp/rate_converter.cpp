@@ -79,6 +79,8 @@ void RateConverter::calculateFilterKernel()
 
 void RateConverter::upsample()
 {
+    FRUT_PROFILE_SCOPE("RateConverter::upsample");
+
     // upsample input sample buffer by clearing it and filling every
     // "upsamplingFactor_" sample with the original sample values
     fftSampleBuffer_.clear();
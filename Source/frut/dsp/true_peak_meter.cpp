@@ -39,6 +39,9 @@ TruePeakMeter::TruePeakMeter(
                              originalFftBufferSize,
                              upsamplingFactor)
 {
+    // "reset" may be called from the audio thread, so allocate all
+    // levels up front
+    truePeakLevels_.insertMultiple(0, 0.0f, numberOfChannels_);
 }
 
 
@@ -51,7 +54,7 @@ void TruePeakMeter::reset()
 {
     RateConverter::reset();
 
-    truePeakLevels_.clear();
+    truePeakLevels_.fill(0.0f);
 }
 
 
@@ -70,6 +73,18 @@ void TruePeakMeter::copyFrom(
 {
     jassert(source.getNumChannels() ==
             numberOfChannels_);
+
+    copyFrom(source, 0, numberOfSamples);
+}
+
+
+void TruePeakMeter::copyFrom(
+    const AudioBuffer<float> &source,
+    const int firstSourceChannel,
+    const int numberOfSamples)
+{
+    jassert(source.getNumChannels() >=
+            firstSourceChannel + numberOfChannels_);
     jassert(source.getNumSamples() >=
             numberOfSamples);
     jassert(originalFftBufferSize_ ==
@@ -80,7 +95,7 @@ void TruePeakMeter::copyFrom(
     {
         sampleBufferOriginal_.copyFrom(channel, 0,
                                        source,
-                                       channel, 0,
+                                       firstSourceChannel + channel, 0,
                                        numberOfSamples);
     }
 
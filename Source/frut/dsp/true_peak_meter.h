@@ -49,6 +49,10 @@ public:
     void copyFrom(const AudioBuffer<float> &source,
                   const int numberOfSamples);
 
+    void copyFrom(const AudioBuffer<float> &source,
+                  const int firstSourceChannel,
+                  const int numberOfSamples);
+
 protected:
     void processInput();
 
@@ -0,0 +1,251 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#if FRUT_DSP_USE_FFTW
+
+namespace frut
+{
+namespace dsp
+{
+
+/// Create a new true peak meter and start its worker threads.
+///
+/// @param numberOfChannels number of audio channels
+///
+/// @param originalFftBufferSize number of samples per chunk
+///
+/// @param upsamplingFactor oversampling factor
+///
+/// @param numberOfWorkers number of worker threads (limited to the
+///        number of channels)
+///
+TruePeakMeterParallel::TruePeakMeterParallel(
+    const int numberOfChannels,
+    const int originalFftBufferSize,
+    const int upsamplingFactor,
+    const int numberOfWorkers) :
+
+    source_(nullptr),
+    numberOfSamples_(0),
+    generation_(0),
+    pendingWorkers_(0)
+{
+#if FRUT_AUDIO_USE_PROFILER
+    profilerInstance_ = nullptr;
+#endif
+
+    jassert(numberOfChannels > 0);
+
+    for (int channel = 0; channel < numberOfChannels; ++channel)
+    {
+        channelMeters_.add(new TruePeakMeter(1,
+                                             originalFftBufferSize,
+                                             upsamplingFactor));
+    }
+
+    int workers = jlimit(1, numberOfChannels, numberOfWorkers);
+
+    for (int workerIndex = 0; workerIndex < workers; ++workerIndex)
+    {
+        Worker *worker = workers_.add(new Worker(*this, workerIndex));
+        worker->startThread();
+    }
+}
+
+
+TruePeakMeterParallel::~TruePeakMeterParallel()
+{
+    for (auto *worker : workers_)
+    {
+        worker->signalThreadShouldExit();
+        worker->notify();
+    }
+
+    for (auto *worker : workers_)
+    {
+        worker->stopThread(1000);
+    }
+}
+
+
+/// Reset all meters.  Must not be called while a chunk is being
+/// processed.
+///
+void TruePeakMeterParallel::reset()
+{
+    jassert(pendingWorkers_.load() == 0);
+
+    for (auto *channelMeter : channelMeters_)
+    {
+        channelMeter->reset();
+    }
+}
+
+
+/// Get true peak level of the last processed chunk.
+///
+/// @param channel audio channel
+///
+/// @return true peak level
+///
+float TruePeakMeterParallel::getLevel(
+    const int channel)
+{
+    jassert(isPositiveAndBelow(channel, channelMeters_.size()));
+
+    return channelMeters_[channel]->getLevel(0);
+}
+
+
+/// Hand a chunk of audio over to the worker threads and return
+/// immediately.  The source buffer must stay valid and unchanged
+/// until finishCopyFrom() returns.
+///
+/// @param source audio buffer (one channel per meter channel)
+///
+/// @param numberOfSamples number of samples per chunk
+///
+void TruePeakMeterParallel::startCopyFrom(
+    const AudioBuffer<float> &source,
+    const int numberOfSamples)
+{
+    jassert(source.getNumChannels() == channelMeters_.size());
+    jassert(pendingWorkers_.load() == 0);
+
+    source_ = &source;
+    numberOfSamples_ = numberOfSamples;
+
+#if FRUT_AUDIO_USE_PROFILER
+    // attribute the workers' events to the calling plug-in instance
+    profilerInstance_ = frut::audio::Profiler::getCurrentInstance();
+#endif
+
+    pendingWorkers_.store(workers_.size());
+
+    // publishes source and number of samples to the workers
+    generation_.fetch_add(1);
+
+    // only workers that have fallen asleep need to be woken up
+    for (auto *worker : workers_)
+    {
+        if (worker->isSleeping.load())
+        {
+            worker->notify();
+        }
+    }
+}
+
+
+/// Wait until the worker threads have processed the current chunk.
+///
+void TruePeakMeterParallel::finishCopyFrom()
+{
+    while (pendingWorkers_.load(std::memory_order_acquire) > 0)
+    {
+        Thread::yield();
+    }
+
+    source_ = nullptr;
+}
+
+
+void TruePeakMeterParallel::processChannels(
+    const int workerIndex)
+{
+#if FRUT_AUDIO_USE_PROFILER
+    FRUT_PROFILE_INSTANCE(profilerInstance_);
+#endif
+
+    // channels are interleaved across workers
+    for (int channel = workerIndex;
+            channel < channelMeters_.size();
+            channel += workers_.size())
+    {
+        channelMeters_[channel]->copyFrom(*source_,
+                                          channel,
+                                          numberOfSamples_);
+    }
+}
+
+
+TruePeakMeterParallel::Worker::Worker(
+    TruePeakMeterParallel &owner,
+    const int workerIndex) :
+
+    Thread("True peak worker " + String(workerIndex + 1)),
+    isSleeping(false),
+    owner_(owner),
+    workerIndex_(workerIndex)
+{
+}
+
+
+void TruePeakMeterParallel::Worker::run()
+{
+    // chunks follow each other closely during offline rendering, so
+    // poll for a while before falling asleep
+    const int pollsUntilSleep = 10000;
+
+    // no chunk has been handed over on construction
+    uint32 processedGeneration = 0;
+    int polls = 0;
+
+    while (!threadShouldExit())
+    {
+        uint32 generation = owner_.generation_.load();
+
+        if (generation != processedGeneration)
+        {
+            processedGeneration = generation;
+            polls = 0;
+
+            owner_.processChannels(workerIndex_);
+            owner_.pendingWorkers_.fetch_sub(1, std::memory_order_release);
+        }
+        else if (polls < pollsUntilSleep)
+        {
+            ++polls;
+            Thread::yield();
+        }
+        else
+        {
+            isSleeping.store(true);
+
+            // re-check to not miss a chunk that has been handed over
+            // in the meantime (notifications are never lost, though)
+            if (owner_.generation_.load() == processedGeneration)
+            {
+                wait(-1);
+            }
+
+            isSleeping.store(false);
+        }
+    }
+}
+
+}
+}
+
+#endif  // FRUT_DSP_USE_FFTW
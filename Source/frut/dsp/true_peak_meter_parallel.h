@@ -0,0 +1,107 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#if FRUT_DSP_USE_FFTW
+
+#ifndef FRUT_DSP_TRUE_PEAK_METER_PARALLEL_H
+#define FRUT_DSP_TRUE_PEAK_METER_PARALLEL_H
+
+namespace frut
+{
+namespace dsp
+{
+
+/// True peak meter that spreads its channels across persistent
+/// worker threads.  Every channel has its own single-channel meter
+/// (and thus its own FFTW buffers), and the channels of each worker
+/// are fixed on construction.  Handing over an audio chunk neither
+/// allocates memory nor locks a mutex, unless a worker has fallen
+/// asleep after a longer pause.
+///
+/// Call startCopyFrom(), do some other work on the calling thread
+/// and then call finishCopyFrom() before reading the levels.
+///
+class TruePeakMeterParallel
+{
+public:
+    TruePeakMeterParallel(const int numberOfChannels,
+                          const int originalFftBufferSize,
+                          const int upsamplingFactor,
+                          const int numberOfWorkers);
+
+    ~TruePeakMeterParallel();
+
+    void reset();
+
+    float getLevel(const int channel);
+
+    void startCopyFrom(const AudioBuffer<float> &source,
+                       const int numberOfSamples);
+    void finishCopyFrom();
+
+protected:
+    class Worker :
+        public Thread
+    {
+    public:
+        Worker(TruePeakMeterParallel &owner,
+               const int workerIndex);
+
+        void run() override;
+
+        std::atomic<bool> isSleeping;
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE(Worker);
+
+        TruePeakMeterParallel &owner_;
+        const int workerIndex_;
+    };
+
+    void processChannels(const int workerIndex);
+
+    OwnedArray<TruePeakMeter> channelMeters_;
+    OwnedArray<Worker> workers_;
+
+    const AudioBuffer<float> *source_;
+    int numberOfSamples_;
+
+    std::atomic<uint32> generation_;
+    std::atomic<int> pendingWorkers_;
+
+#if FRUT_AUDIO_USE_PROFILER
+    const void *profilerInstance_;
+#endif
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TruePeakMeterParallel);
+};
+
+}
+}
+
+#endif  // FRUT_DSP_TRUE_PEAK_METER_PARALLEL_H
+
+#endif  // FRUT_DSP_USE_FFTW
@@ -0,0 +1,188 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+namespace frut
+{
+namespace skin
+{
+
+JUCE_IMPLEMENT_SINGLETON(ImageFileCache)
+
+
+/// Create an empty image cache.  Please use getInstance() instead.
+///
+ImageFileCache::ImageFileCache()
+{
+}
+
+
+/// Destructor.
+///
+ImageFileCache::~ImageFileCache()
+{
+    clearSingletonInstance();
+}
+
+
+/// Load image from file.  The image is only decoded when it has not
+/// been cached or when the file has been modified since.
+///
+/// @param fileImage image file
+///
+/// @return decoded image (invalid if file could not be decoded);
+///         shared with all other callers
+///
+Image ImageFileCache::loadImage(
+    const File &fileImage)
+
+{
+    String cacheKey = fileImage.getFullPathName();
+    Time modificationTime = fileImage.getLastModificationTime();
+
+    const ScopedLock lock(lock_);
+
+    Image image;
+
+    if (!getCachedImage(cacheKey, modificationTime, image))
+    {
+        image = ImageFileFormat::loadFrom(fileImage);
+        setCachedImage(cacheKey, modificationTime, image);
+    }
+
+    return image;
+}
+
+
+/// Load image from memory (for example, an image file in a skin
+/// bundle).  The image is only decoded when it has not been cached
+/// under the given key or when its modification time has changed.
+///
+/// @param cacheKey unique name of image
+///
+/// @param modificationTime modification time of image data
+///
+/// @param imageData encoded image
+///
+/// @param dataSize size of encoded image (in bytes)
+///
+/// @return decoded image (invalid if data could not be decoded);
+///         shared with all other callers
+///
+Image ImageFileCache::loadImage(
+    const String &cacheKey,
+    const Time &modificationTime,
+    const void *imageData,
+    size_t dataSize)
+
+{
+    const ScopedLock lock(lock_);
+
+    Image image;
+
+    if (!getCachedImage(cacheKey, modificationTime, image))
+    {
+        image = ImageFileFormat::loadFrom(imageData, dataSize);
+        setCachedImage(cacheKey, modificationTime, image);
+    }
+
+    return image;
+}
+
+
+/// Look up image in cache.  Lock must be held by caller.
+///
+/// @param cacheKey unique name of image
+///
+/// @param modificationTime modification time of image
+///
+/// @param image will be set to cached image (if found)
+///
+/// @return **true** if image was found and is up to date
+///
+bool ImageFileCache::getCachedImage(
+    const String &cacheKey,
+    const Time &modificationTime,
+    Image &image)
+
+{
+    if (!cachedImages_.contains(cacheKey))
+    {
+        return false;
+    }
+
+    CachedImage cachedImage = cachedImages_[cacheKey];
+
+    if (cachedImage.modificationTime != modificationTime)
+    {
+        return false;
+    }
+
+    image = cachedImage.image;
+    return true;
+}
+
+
+/// Store image in cache.  Lock must be held by caller.
+///
+/// @param cacheKey unique name of image
+///
+/// @param modificationTime modification time of image
+///
+/// @param image decoded image
+///
+void ImageFileCache::setCachedImage(
+    const String &cacheKey,
+    const Time &modificationTime,
+    const Image &image)
+
+{
+    // do not cache failures, the file might still be written
+    if (!image.isValid())
+    {
+        cachedImages_.remove(cacheKey);
+        return;
+    }
+
+    CachedImage cachedImage;
+
+    cachedImage.modificationTime = modificationTime;
+    cachedImage.image = image;
+
+    cachedImages_.set(cacheKey, cachedImage);
+}
+
+
+/// Release all cached images.  Images that are still in use remain
+/// valid.
+///
+void ImageFileCache::clear()
+{
+    const ScopedLock lock(lock_);
+
+    cachedImages_.clear();
+}
+
+}
+}
@@ -0,0 +1,83 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef FRUT_SKIN_IMAGE_FILE_CACHE_H
+#define FRUT_SKIN_IMAGE_FILE_CACHE_H
+
+namespace frut
+{
+namespace skin
+{
+
+/// Process-wide cache of decoded image files.  Images are keyed by
+/// their full path and modification time, so changing a skin on
+/// disk is picked up on the next load, while switching skin states
+/// and opening further editors neither reads nor decodes any file.
+///
+/// Cached images are shared between all callers.  Please create a
+/// copy before drawing into an image!
+///
+class ImageFileCache :
+    public DeletedAtShutdown
+{
+public:
+    ImageFileCache();
+    ~ImageFileCache();
+
+    Image loadImage(const File &fileImage);
+    Image loadImage(const String &cacheKey,
+                    const Time &modificationTime,
+                    const void *imageData,
+                    size_t dataSize);
+
+    void clear();
+
+    JUCE_DECLARE_SINGLETON(ImageFileCache, false)
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImageFileCache);
+
+    struct CachedImage
+    {
+        Time modificationTime;
+        Image image;
+    };
+
+    bool getCachedImage(const String &cacheKey,
+                        const Time &modificationTime,
+                        Image &image);
+
+    void setCachedImage(const String &cacheKey,
+                        const Time &modificationTime,
+                        const Image &image);
+
+    CriticalSection lock_;
+    HashMap<String, CachedImage> cachedImages_;
+};
+
+}
+}
+
+#endif  // FRUT_SKIN_IMAGE_FILE_CACHE_H
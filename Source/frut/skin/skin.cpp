@@ -42,18 +42,11 @@ bool Skin::loadFromXml(
     const String &rootName,
     const String &assumedVersionNumber)
 {
-    settingsGroup_ = nullptr;
-    skinGroup_ = nullptr;
-    skinFallback_1_ = nullptr;
-    skinFallback_2_ = nullptr;
-
-    backgroundWidth_ = 0;
-    backgroundHeight_ = 0;
-
     Logger::outputDebugString(
         String("[Skin] loading file \"") +
         skinFile.getFileName() + "\"");
 
+    bundle_.close();
     document_ = juce::parseXML(skinFile);
 
     if (document_ == nullptr)
@@ -62,7 +55,123 @@ bool Skin::loadFromXml(
             String("[Skin] file \"") +
             skinFile.getFullPathName() +
             "\" not found");
+    }
+
+    if (!initialiseDocument(skinFile.getFileName(),
+                            rootName,
+                            assumedVersionNumber))
+    {
+        return false;
+    }
+
+    String resourcePathName = getString(document_.get(), "path");
+    resourcePath_ = File(skinFile.getSiblingFile(resourcePathName));
+
+    if (!resourcePath_.isDirectory())
+    {
+        Logger::outputDebugString(
+            String("[Skin] directory \"") +
+            resourcePath_.getFullPathName() +
+            "\" not found");
+
+        document_ = nullptr;
+        initialiseDocument(skinFile.getFileName(),
+                           rootName,
+                           assumedVersionNumber);
+
+        return false;
+    }
+
+    return true;
+}
+
+
+// Loads a compiled skin (see SkinBundle).  All images are read from
+// the bundle, so no skin directory is needed.
+bool Skin::loadFromBundle(
+    const File &bundleFile,
+    const String &rootName,
+    const String &assumedVersionNumber)
+{
+    Logger::outputDebugString(
+        String("[Skin] loading bundle \"") +
+        bundleFile.getFileName() + "\"");
+
+    resourcePath_ = File();
+
+    if (bundle_.openFile(bundleFile))
+    {
+        document_ = bundle_.getDocument();
+    }
+    else
+    {
+        document_ = nullptr;
+    }
+
+    if (!initialiseDocument(bundleFile.getFileName(),
+                            rootName,
+                            assumedVersionNumber))
+    {
+        bundle_.close();
+        return false;
+    }
+
+    return true;
+}
+
+
+// Loads a compiled skin from memory (for example, a skin that has
+// been compiled into the binary).  The data must remain valid while
+// the skin is in use.
+bool Skin::loadFromBundle(
+    const void *bundleData,
+    size_t bundleSize,
+    const String &rootName,
+    const String &assumedVersionNumber)
+{
+    Logger::outputDebugString(
+        "[Skin] loading bundle from memory");
+
+    resourcePath_ = File();
+
+    if (bundle_.openMemory(bundleData, bundleSize))
+    {
+        document_ = bundle_.getDocument();
+    }
+    else
+    {
+        document_ = nullptr;
+    }
+
+    if (!initialiseDocument("(memory)",
+                            rootName,
+                            assumedVersionNumber))
+    {
+        bundle_.close();
+        return false;
+    }
+
+    return true;
+}
+
+
+// Resets skin groups and checks the freshly loaded document.
+bool Skin::initialiseDocument(
+    const String &skinName,
+    const String &rootName,
+    const String &assumedVersionNumber)
+{
+    settingsGroup_ = nullptr;
+    skinGroup_ = nullptr;
+    skinFallback_1_ = nullptr;
+    skinFallback_2_ = nullptr;
+
+    backgroundWidth_ = 0;
+    backgroundHeight_ = 0;
 
+    if (document_ == nullptr)
+    {
+        buildIndex();
         return false;
     }
 
@@ -72,7 +181,7 @@ bool Skin::loadFromXml(
     {
         Logger::outputDebugString(
             String("[Skin] file \"") +
-            skinFile.getFileName() +
+            skinName +
             "\" has incompatible version number \"" +
             skinVersion +
             "\"");
@@ -91,42 +200,76 @@ bool Skin::loadFromXml(
 
         document_ = nullptr;
 
+        settingsGroup_ = nullptr;
+        skinFallback_2_ = nullptr;
+
+        buildIndex();
         return false;
     }
-    else
+
+    skinGroup_ = document_->getChildByName(currentGroupName_);
+
+    if (skinGroup_ == nullptr)
     {
-        skinGroup_ = document_->getChildByName(currentGroupName_);
+        Logger::outputDebugString(
+            String("[Skin] XML element \"") +
+            currentGroupName_ +
+            "\" not found in settings");
+    }
 
-        if (skinGroup_ == nullptr)
-        {
-            Logger::outputDebugString(
-                String("[Skin] XML element \"") +
-                currentGroupName_ +
-                "\" not found in settings");
-        }
+    skinFallback_1_ = document_->getChildByName(currentFallbackName_);
 
-        skinFallback_1_ = document_->getChildByName(currentFallbackName_);
+    String originOfY = getString(document_.get(), "origin_of_y", "top");
+    originOfYIsBottom_ = originOfY.compare("bottom") == 0;
 
-        String resourcePathName = getString(document_.get(), "path");
-        resourcePath_ = File(skinFile.getSiblingFile(resourcePathName));
+    buildIndex();
 
-        if (!resourcePath_.isDirectory())
-        {
-            Logger::outputDebugString(
-                String("[Skin] directory \"") +
-                resourcePath_.getFullPathName() +
-                "\" not found");
+    return true;
+}
+
+
+// Builds hash maps of settings and components, so that look-ups do
+// not have to search the XML document.  Has to be called whenever
+// the document or one of the skin groups changes.
+void Skin::buildIndex()
+{
+    settingsIndex_.clear();
+    componentIndex_.clear();
 
-            document_ = nullptr;
+    if (settingsGroup_ != nullptr)
+    {
+        forEachXmlChildElement(*settingsGroup_, xmlSetting)
+        {
+            String tagName = xmlSetting->getTagName();
 
-            return false;
+            // like getChildByName(), prefer the first element
+            if (!settingsIndex_.contains(tagName))
+            {
+                settingsIndex_.set(tagName, xmlSetting);
+            }
         }
     }
 
-    String originOfY = getString(document_.get(), "origin_of_y", "top");
-    originOfYIsBottom_ = originOfY.compare("bottom") == 0;
+    // skin group takes precedence over its fallbacks
+    XmlElement *skinGroups[] = {skinGroup_, skinFallback_1_, skinFallback_2_};
 
-    return true;
+    for (XmlElement *skinGroup : skinGroups)
+    {
+        if (skinGroup == nullptr)
+        {
+            continue;
+        }
+
+        forEachXmlChildElement(*skinGroup, xmlComponent)
+        {
+            String tagName = xmlComponent->getTagName();
+
+            if (!componentIndex_.contains(tagName))
+            {
+                componentIndex_.set(tagName, xmlComponent);
+            }
+        }
+    }
 }
 
 
@@ -141,7 +284,7 @@ XmlElement *Skin::getSetting(
         return nullptr;
     }
 
-    XmlElement *xmlSetting = settingsGroup_->getChildByName(tagName);
+    XmlElement *xmlSetting = settingsIndex_[tagName];
 
     if (xmlSetting == nullptr)
     {
@@ -160,36 +303,20 @@ XmlElement *Skin::getSetting(
 XmlElement *Skin::getComponent(
     const String &tagName)
 {
-    XmlElement *xmlComponent;
-
     // suppress unnecessary warnings and save some time
     if (document_ == nullptr)
     {
-        xmlComponent = nullptr;
-    }
-    else if ((skinGroup_ != nullptr) &&
-             (skinGroup_->getChildByName(tagName) != nullptr))
-    {
-        xmlComponent = skinGroup_->getChildByName(tagName);
-    }
-    else if ((skinFallback_1_ != nullptr) &&
-             (skinFallback_1_->getChildByName(tagName) != nullptr))
-    {
-        xmlComponent = skinFallback_1_->getChildByName(tagName);
-    }
-    else if ((skinFallback_2_ != nullptr) &&
-             (skinFallback_2_->getChildByName(tagName) != nullptr))
-    {
-        xmlComponent = skinFallback_2_->getChildByName(tagName);
+        return nullptr;
     }
-    else
+
+    XmlElement *xmlComponent = componentIndex_[tagName];
+
+    if (xmlComponent == nullptr)
     {
         Logger::outputDebugString(
             String("[Skin] XML element \"") +
             tagName +
             "\" not found");
-
-        xmlComponent = nullptr;
     }
 
     return xmlComponent;
@@ -293,11 +420,27 @@ void Skin::loadImage(
     const String &strFilename,
     Image &image)
 {
+    // compiled skin
+    if (bundle_.isOpen())
+    {
+        image = bundle_.getImage(strFilename);
+
+        if (!image.isValid())
+        {
+            Logger::outputDebugString(
+                String("[Skin] image \"") +
+                strFilename +
+                "\" not found in bundle");
+        }
+
+        return;
+    }
+
     File fileImage = resourcePath_.getChildFile(strFilename);
 
     if (fileImage.existsAsFile())
     {
-        image = ImageFileFormat::loadFrom(fileImage);
+        image = ImageFileCache::getInstance()->loadImage(fileImage);
     }
     else
     {
@@ -342,6 +485,7 @@ void Skin::setBackgroundImage(
         backgroundHeight_ = imageBackground.getHeight();
 
         XmlElement *xmlMeterGraduation = nullptr;
+        bool hasCopiedBackground = false;
 
         // get rid of the "unused variable" warning
         (void) xmlMeterGraduation;
@@ -361,6 +505,13 @@ void Skin::setBackgroundImage(
                 int height = imageMeterGraduation.getHeight();
                 Point<int> position = getPosition(xmlMeterGraduation, height);
 
+                // cached images are shared, so draw into a copy
+                if (!hasCopiedBackground)
+                {
+                    imageBackground = imageBackground.createCopy();
+                    hasCopiedBackground = true;
+                }
+
                 Graphics g(imageBackground);
                 g.drawImageAt(imageMeterGraduation,
                               position.getX(), position.getY(),
@@ -612,6 +763,27 @@ void Skin::placeAndSkinLabel(
 }
 
 
+void Skin::placeAndSkinTextLabel(
+    const String &tagName,
+    Label *label)
+{
+    jassert(label != nullptr);
+
+    XmlElement *xmlComponent = getComponent(tagName);
+
+    if (xmlComponent != nullptr)
+    {
+        int font_size = getInteger(xmlComponent, "font_size", 12);
+
+        Font font = label->getFont();
+        font.setHeight(static_cast<float>(font_size));
+        label->setFont(font);
+
+        placeComponent(xmlComponent, label);
+    }
+}
+
+
 void Skin::placeAndSkinSignalLed(
     const String &tagName,
     widgets::SignalLed *label)
@@ -697,7 +869,7 @@ void Skin::placeAndSkinStateLabel(
         }
         else
         {
-            imageActive = imageOn.createCopy();
+            imageActive = imageOn;
         }
 
         int spacing_left = getInteger(xmlComponent, "spacing_left", 0);
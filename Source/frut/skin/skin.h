@@ -38,6 +38,15 @@ public:
                      const String &rootName,
                      const String &assumedVersionNumber);
 
+    bool loadFromBundle(const File &bundleFile,
+                        const String &rootName,
+                        const String &assumedVersionNumber);
+
+    bool loadFromBundle(const void *bundleData,
+                        size_t bundleSize,
+                        const String &rootName,
+                        const String &assumedVersionNumber);
+
     XmlElement *getSetting(const String &tagName);
 
     XmlElement *getComponent(const String &tagName);
@@ -96,6 +105,9 @@ public:
     void placeAndSkinLabel(const String &tagName,
                            ImageComponent *label);
 
+    void placeAndSkinTextLabel(const String &tagName,
+                               Label *label);
+
     void placeAndSkinSignalLed(const String &tagName,
                                widgets::SignalLed *label);
 
@@ -103,7 +115,19 @@ public:
                                 widgets::StateLabel *label);
 
 protected:
+    bool initialiseDocument(const String &skinName,
+                            const String &rootName,
+                            const String &assumedVersionNumber);
+
+    void buildIndex();
+
     std::unique_ptr<XmlElement> document_;
+    SkinBundle bundle_;
+
+    // XML elements by tag name (components are already resolved
+    // through the fallback groups)
+    HashMap<String, XmlElement *> settingsIndex_;
+    HashMap<String, XmlElement *> componentIndex_;
 
     XmlElement *settingsGroup_;
     XmlElement *skinGroup_;
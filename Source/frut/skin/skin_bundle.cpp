@@ -0,0 +1,551 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+namespace frut
+{
+namespace skin
+{
+
+const char *SkinBundle::magic_ = "FRUTSKIN";
+const int SkinBundle::formatVersion_ = 1;
+const int SkinBundle::headerSize_ = 32;
+
+
+/// Create a closed skin bundle.
+///
+SkinBundle::SkinBundle() :
+    data_(nullptr),
+    size_(0)
+{
+}
+
+
+/// Compile an XML skin and its resource directory into a skin bundle
+/// (the resource directory is taken from the skin's "path"
+/// attribute).
+///
+/// @param skinFile XML skin file
+///
+/// @param bundleFile skin bundle to write (will be overwritten)
+///
+/// @param wildcardPattern only bundle resource files that match this
+///        pattern (such as "*.png"); separate several patterns with
+///        semicolons
+///
+/// @return **true** on success, **false** otherwise
+///
+bool SkinBundle::writeBundle(
+    const File &skinFile,
+    const File &bundleFile,
+    const String &wildcardPattern)
+
+{
+    std::unique_ptr<XmlElement> document = juce::parseXML(skinFile);
+
+    if (document == nullptr)
+    {
+        Logger::outputDebugString(
+            String("[Skin] file \"") +
+            skinFile.getFullPathName() +
+            "\" could not be parsed");
+
+        return false;
+    }
+
+    String resourcePathName = document->getStringAttribute("path");
+    File resourcePath = skinFile.getSiblingFile(resourcePathName);
+
+    if (!resourcePath.isDirectory())
+    {
+        Logger::outputDebugString(
+            String("[Skin] directory \"") +
+            resourcePath.getFullPathName() +
+            "\" not found");
+
+        return false;
+    }
+
+    // store XML document verbatim
+    MemoryBlock documentData;
+
+    if (!skinFile.loadFileAsData(documentData))
+    {
+        return false;
+    }
+
+    Array<File> resourceFiles = resourcePath.findChildFiles(
+                                    File::findFiles, true, wildcardPattern);
+
+    // keep bundles reproducible
+    resourceFiles.sort();
+
+    StringArray entryNames;
+    OwnedArray<MemoryBlock> entryData;
+    int64 indexSize = 0;
+
+    for (int index = 0; index < resourceFiles.size(); ++index)
+    {
+        File resourceFile = resourceFiles[index];
+
+        String entryName = resourceFile.getRelativePathFrom(resourcePath)
+                           .replaceCharacter('\\', '/');
+
+        MemoryBlock *resourceData = entryData.add(new MemoryBlock());
+
+        if (!resourceFile.loadFileAsData(*resourceData))
+        {
+            return false;
+        }
+
+        entryNames.add(entryName);
+
+        // name length, name, offset and size
+        indexSize += 4 + static_cast<int64>(entryName.getNumBytesAsUTF8()) + 8 + 8;
+    }
+
+    // write to temporary file, so that bundles which are currently
+    // in use are replaced in one go
+    TemporaryFile temporaryFile(bundleFile);
+
+    {
+        FileOutputStream outputStream(temporaryFile.getFile());
+
+        if (outputStream.failedToOpen())
+        {
+            Logger::outputDebugString(
+                String("[Skin] file \"") +
+                bundleFile.getFullPathName() +
+                "\" could not be written");
+
+            return false;
+        }
+
+        int64 offset = headerSize_ + indexSize;
+
+        // header
+        outputStream.write(magic_, 8);
+        outputStream.writeInt(formatVersion_);
+        outputStream.writeInt(entryNames.size());
+
+        outputStream.writeInt64(offset);
+        outputStream.writeInt64(static_cast<int64>(documentData.getSize()));
+        offset += static_cast<int64>(documentData.getSize());
+
+        // index
+        for (int index = 0; index < entryNames.size(); ++index)
+        {
+            String entryName = entryNames[index];
+            int64 entrySize = static_cast<int64>(entryData[index]->getSize());
+            int nameLength = static_cast<int>(entryName.getNumBytesAsUTF8());
+
+            outputStream.writeInt(nameLength);
+            outputStream.write(entryName.toRawUTF8(),
+                               static_cast<size_t>(nameLength));
+            outputStream.writeInt64(offset);
+            outputStream.writeInt64(entrySize);
+
+            offset += entrySize;
+        }
+
+        // data
+        outputStream.write(documentData.getData(), documentData.getSize());
+
+        for (int index = 0; index < entryData.size(); ++index)
+        {
+            outputStream.write(entryData[index]->getData(),
+                               entryData[index]->getSize());
+        }
+
+        outputStream.flush();
+
+        if (outputStream.getStatus().failed())
+        {
+            return false;
+        }
+    }
+
+    return temporaryFile.overwriteTargetFileWithTemporary();
+}
+
+
+/// Get the newest modification time of a skin's sources, that is
+/// the XML document, its resource directory and everything within.
+///
+/// @param skinFile XML document of the skin
+///
+/// @return newest modification time
+///
+Time SkinBundle::getSourceModificationTime(
+    const File &skinFile)
+
+{
+    Time newestTime = skinFile.getLastModificationTime();
+
+    // only the root element is needed to locate the resources
+    XmlDocument xmlDocument(skinFile);
+    std::unique_ptr<XmlElement> rootElement(
+        xmlDocument.getDocumentElement(true));
+
+    if (rootElement == nullptr)
+    {
+        return newestTime;
+    }
+
+    String resourcePathName = rootElement->getStringAttribute("path");
+    File resourcePath = skinFile.getSiblingFile(resourcePathName);
+
+    if (!resourcePath.isDirectory())
+    {
+        return newestTime;
+    }
+
+    // directories change when files are added or removed
+    if (resourcePath.getLastModificationTime() > newestTime)
+    {
+        newestTime = resourcePath.getLastModificationTime();
+    }
+
+    DirectoryIterator iterator(resourcePath, true, "*",
+                               File::findFilesAndDirectories);
+
+    Time modificationTime;
+
+    while (iterator.next(nullptr, nullptr, nullptr,
+                         &modificationTime, nullptr, nullptr))
+    {
+        if (modificationTime > newestTime)
+        {
+            newestTime = modificationTime;
+        }
+    }
+
+    return newestTime;
+}
+
+
+/// Check whether a bundle is at least as new as all sources of its
+/// skin.  Bundles of skins that only ship in compiled form are
+/// always up to date.
+///
+/// @param skinFile XML document of the skin
+///
+/// @param bundleFile compiled skin
+///
+/// @return true if the bundle may be used
+///
+bool SkinBundle::isUpToDate(
+    const File &skinFile,
+    const File &bundleFile)
+
+{
+    if (!bundleFile.existsAsFile())
+    {
+        return false;
+    }
+
+    if (!skinFile.existsAsFile())
+    {
+        return true;
+    }
+
+    return bundleFile.getLastModificationTime() >=
+           getSourceModificationTime(skinFile);
+}
+
+
+/// Open skin bundle from file.  The file is memory-mapped and must
+/// not be changed while the bundle is open.
+///
+/// @param bundleFile skin bundle
+///
+/// @return **true** on success, **false** otherwise
+///
+bool SkinBundle::openFile(
+    const File &bundleFile)
+
+{
+    close();
+
+    mappedFile_ = std::make_unique<MemoryMappedFile>(
+                      bundleFile, MemoryMappedFile::readOnly);
+
+    if (mappedFile_->getData() == nullptr)
+    {
+        Logger::outputDebugString(
+            String("[Skin] file \"") +
+            bundleFile.getFullPathName() +
+            "\" not found");
+
+        close();
+        return false;
+    }
+
+    data_ = static_cast<const uint8 *>(mappedFile_->getData());
+    size_ = mappedFile_->getSize();
+
+    cacheKey_ = bundleFile.getFullPathName() + ":";
+    modificationTime_ = bundleFile.getLastModificationTime();
+
+    if (!readIndex())
+    {
+        Logger::outputDebugString(
+            String("[Skin] file \"") +
+            bundleFile.getFullPathName() +
+            "\" is not a valid skin bundle");
+
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+
+/// Open skin bundle from memory (for example, binary resources).
+/// The data is not copied and must remain valid while the bundle is
+/// open.
+///
+/// @param bundleData skin bundle
+///
+/// @param bundleSize size of skin bundle (in bytes)
+///
+/// @return **true** on success, **false** otherwise
+///
+bool SkinBundle::openMemory(
+    const void *bundleData,
+    size_t bundleSize)
+
+{
+    close();
+
+    data_ = static_cast<const uint8 *>(bundleData);
+    size_ = bundleSize;
+
+    cacheKey_ = String("memory:") +
+                String::toHexString(reinterpret_cast<pointer_sized_int>(bundleData)) +
+                ":";
+    modificationTime_ = Time();
+
+    if (!readIndex())
+    {
+        Logger::outputDebugString(
+            "[Skin] memory block is not a valid skin bundle");
+
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+
+/// Close skin bundle.  Images that have already been loaded remain
+/// valid.
+///
+void SkinBundle::close()
+{
+    entries_.clear();
+    document_ = Range<int64>();
+
+    data_ = nullptr;
+    size_ = 0;
+
+    mappedFile_ = nullptr;
+}
+
+
+/// Find out whether the skin bundle is open.
+///
+/// @return **true** if bundle is open
+///
+bool SkinBundle::isOpen() const
+{
+    return data_ != nullptr;
+}
+
+
+/// Read and check header and index of skin bundle.
+///
+/// @return **true** if bundle is valid, **false** otherwise
+///
+bool SkinBundle::readIndex()
+{
+    entries_.clear();
+
+    uint64 bundleSize = static_cast<uint64>(size_);
+
+    // checks that a range lies completely within the bundle
+    auto isInside = [bundleSize](uint64 offset, uint64 size)
+    {
+        return (offset <= bundleSize) && (size <= bundleSize - offset);
+    };
+
+    if ((data_ == nullptr) || !isInside(0, headerSize_))
+    {
+        return false;
+    }
+
+    if (memcmp(data_, magic_, 8) != 0)
+    {
+        return false;
+    }
+
+    if (ByteOrder::littleEndianInt(data_ + 8) != static_cast<uint32>(formatVersion_))
+    {
+        return false;
+    }
+
+    uint32 numberOfEntries = ByteOrder::littleEndianInt(data_ + 12);
+    uint64 documentOffset = ByteOrder::littleEndianInt64(data_ + 16);
+    uint64 documentSize = ByteOrder::littleEndianInt64(data_ + 24);
+
+    if (!isInside(documentOffset, documentSize))
+    {
+        return false;
+    }
+
+    document_ = Range<int64>(static_cast<int64>(documentOffset),
+                             static_cast<int64>(documentOffset + documentSize));
+
+    uint64 position = headerSize_;
+
+    for (uint32 entry = 0; entry < numberOfEntries; ++entry)
+    {
+        if (!isInside(position, 4))
+        {
+            return false;
+        }
+
+        uint32 nameLength = ByteOrder::littleEndianInt(data_ + position);
+        position += 4;
+
+        if (!isInside(position, static_cast<uint64>(nameLength) + 16))
+        {
+            return false;
+        }
+
+        String entryName = String::fromUTF8(
+                               reinterpret_cast<const char *>(data_ + position),
+                               static_cast<int>(nameLength));
+        position += nameLength;
+
+        uint64 entryOffset = ByteOrder::littleEndianInt64(data_ + position);
+        uint64 entrySize = ByteOrder::littleEndianInt64(data_ + position + 8);
+        position += 16;
+
+        if (!isInside(entryOffset, entrySize))
+        {
+            return false;
+        }
+
+        entries_.set(entryName,
+                     Range<int64>(static_cast<int64>(entryOffset),
+                                  static_cast<int64>(entryOffset + entrySize)));
+    }
+
+    return true;
+}
+
+
+/// Get data of an entry.
+///
+/// @param entryName name of entry (path relative to resource
+///        directory)
+///
+/// @param entryData will be set to the entry's data
+///
+/// @param entrySize will be set to the entry's size (in bytes)
+///
+/// @return **true** if entry exists, **false** otherwise
+///
+bool SkinBundle::getEntry(
+    const String &entryName,
+    const uint8 *&entryData,
+    size_t &entrySize) const
+
+{
+    if (!entries_.contains(entryName))
+    {
+        return false;
+    }
+
+    Range<int64> entryRange = entries_[entryName];
+
+    entryData = data_ + entryRange.getStart();
+    entrySize = static_cast<size_t>(entryRange.getLength());
+
+    return true;
+}
+
+
+/// Parse the skin's XML document.
+///
+/// @return XML document (or **nullptr** if bundle is not open)
+///
+std::unique_ptr<XmlElement> SkinBundle::getDocument() const
+{
+    if (!isOpen())
+    {
+        return nullptr;
+    }
+
+    String documentText = String::fromUTF8(
+                              reinterpret_cast<const char *>(data_ + document_.getStart()),
+                              static_cast<int>(document_.getLength()));
+
+    return juce::parseXML(documentText);
+}
+
+
+/// Load image from skin bundle.  Decoded images are shared with all
+/// editors that use the same bundle.
+///
+/// @param entryName name of image (path relative to resource
+///        directory)
+///
+/// @return decoded image (invalid if image was not found or could
+///         not be decoded)
+///
+Image SkinBundle::getImage(
+    const String &entryName) const
+
+{
+    const uint8 *entryData;
+    size_t entrySize;
+
+    if (!getEntry(entryName, entryData, entrySize))
+    {
+        return Image();
+    }
+
+    return ImageFileCache::getInstance()->loadImage(
+               cacheKey_ + entryName,
+               modificationTime_,
+               entryData,
+               entrySize);
+}
+
+}
+}
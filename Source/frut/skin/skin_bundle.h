@@ -0,0 +1,111 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef FRUT_SKIN_SKIN_BUNDLE_H
+#define FRUT_SKIN_SKIN_BUNDLE_H
+
+namespace frut
+{
+namespace skin
+{
+
+/// Compiled skin.  A skin bundle is a single file that contains a
+/// skin's XML document and all files from its resource directory, so
+/// skins can be loaded without a skin directory and without reading
+/// any further files.  Bundles are memory-mapped (or read directly
+/// from memory, e.g. when compiled into the binary) and their
+/// entries are looked up in a hash map.
+///
+/// > #### File format
+/// >
+/// > All integers are stored in little-endian byte order.  Offsets
+/// > are counted from the start of the bundle.
+/// >
+/// > | Size      | Contents                                      |
+/// > | :-------: | :-------------------------------------------- |
+/// > | 8         | magic ("FRUTSKIN")                            |
+/// > | 4         | format version                                |
+/// > | 4         | number of entries                             |
+/// > | 8 + 8     | offset and size of XML document (UTF-8)       |
+/// > | per entry | name length (4), name (UTF-8), offset (8) and |
+/// > |           | size (8)                                      |
+/// > | ...       | data                                          |
+/// >
+/// > Entries are named after their path relative to the resource
+/// > directory (using forward slashes).  Images are stored in their
+/// > original (PNG) format, which decodes quickly and keeps bundles
+/// > small.
+///
+class SkinBundle
+{
+public:
+    SkinBundle();
+
+    static bool writeBundle(const File &skinFile,
+                            const File &bundleFile,
+                            const String &wildcardPattern = "*");
+
+    static Time getSourceModificationTime(const File &skinFile);
+    static bool isUpToDate(const File &skinFile,
+                           const File &bundleFile);
+
+    bool openFile(const File &bundleFile);
+    bool openMemory(const void *bundleData,
+                    size_t bundleSize);
+    void close();
+
+    bool isOpen() const;
+
+    std::unique_ptr<XmlElement> getDocument() const;
+    Image getImage(const String &entryName) const;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SkinBundle);
+
+    bool readIndex();
+    bool getEntry(const String &entryName,
+                  const uint8 *&entryData,
+                  size_t &entrySize) const;
+
+    static const char *magic_;
+    static const int formatVersion_;
+    static const int headerSize_;
+
+    std::unique_ptr<MemoryMappedFile> mappedFile_;
+
+    const uint8 *data_;
+    size_t size_;
+
+    Range<int64> document_;
+    HashMap<String, Range<int64>> entries_;
+
+    String cacheKey_;
+    Time modificationTime_;
+};
+
+}
+}
+
+#endif  // FRUT_SKIN_SKIN_BUNDLE_H
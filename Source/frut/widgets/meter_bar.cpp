@@ -30,7 +30,10 @@ namespace widgets
 
 /// Default constructor.
 ///
-MeterBar::MeterBar()
+MeterBar::MeterBar() :
+    levelTableResolution_(0.1f),
+    isSingleComponent_(false)
+
 {
     // initialize variables
     create();
@@ -38,7 +41,8 @@ MeterBar::MeterBar()
 
 
 /// Create a new meter bar (and delete an existing one).  The meter
-/// bar can be filled using addSegment() and its cousins.
+/// bar can be filled using addSegment() and its cousins.  The
+/// single-component mode is not changed.
 ///
 void MeterBar::create()
 {
@@ -72,6 +76,16 @@ void MeterBar::create()
     // clear array with segment spacings
     segmentSpacing_.clear();
 
+    // clear segment level ranges and level table
+    segmentLevelRanges_.clear();
+    segmentIsContinuous_.clear();
+    levelTable_.clear();
+    levelTableMinimum_ = initialLevel;
+
+    // clear segment atlas
+    segmentAtlas_ = Image();
+    segmentAtlasScale_ = 1.0f;
+
     // set initial orientation
     orientation_ = widgets::Orientation::vertical;
     isVertical_ = true;
@@ -118,6 +132,14 @@ void MeterBar::addSegment(
     // add segment to meter bar
     meterSegments_.add(segment);
 
+    // level range is unknown; will be set by addDiscreteSegment()
+    // and its cousins
+    segmentLevelRanges_.add(Range<float>());
+    segmentIsContinuous_.add(false);
+
+    // level table has to be re-built
+    levelTable_.clear();
+
     // set dimensions of meter segment; remember that we always use
     // the coordinates for a vertical meter!
     segment->setBounds(0,
@@ -132,7 +154,14 @@ void MeterBar::addSegment(
     setOrientation(orientationOld);
 
     // show meter segment
-    addAndMakeVisible(segment);
+    if (isSingleComponent_)
+    {
+        segment->setEnabled(isEnabled());
+    }
+    else
+    {
+        addAndMakeVisible(segment);
+    }
 
     // update dimensions of meter bar
     resized();
@@ -201,6 +230,17 @@ void MeterBar::addDiscreteSegment(
         segment,
         segmentHeight,
         spacingBefore);
+
+    // fading segments change without any change in level, so their
+    // level range must not be looked up
+    if (retainSignalFactor <= 0.0f)
+    {
+        int index = meterSegments_.size() - 1;
+
+        segmentLevelRanges_.set(
+            index, Range<float>(lowerThreshold,
+                                lowerThreshold + thresholdRange));
+    }
 }
 
 
@@ -259,6 +299,13 @@ void MeterBar::addContinuousSegment(
         segmentHeight,
         spacingBefore);
 
+    int index = meterSegments_.size() - 1;
+
+    segmentLevelRanges_.set(
+        index, Range<float>(lowerThreshold,
+                            lowerThreshold + thresholdRange));
+    segmentIsContinuous_.set(index, true);
+
     // add (slightly) bigger margin to top-most segment
     if (isTopmost)
     {
@@ -454,6 +501,15 @@ void MeterBar::setOrientation(
 
         segment->setOrientation(orientation_);
     }
+
+    // segment atlas has to be re-rendered
+    segmentAtlas_ = Image();
+
+    // segments do not repaint themselves in single-component mode
+    if (isSingleComponent_)
+    {
+        repaint();
+    }
 }
 
 
@@ -505,6 +561,59 @@ bool MeterBar::isMeterInverted()
 }
 
 
+/// Find out whether the meter bar draws all meter segments itself.
+///
+/// @return **true** if meter bar is in single-component mode
+///
+bool MeterBar::isSingleComponent()
+{
+    return isSingleComponent_;
+}
+
+
+/// Set single-component mode.  In this mode, meter segments are not
+/// added as child components, but drawn in the meter bar's paint().
+/// Only those pixels that are affected by a level change are
+/// repainted, which is looked up in a table (see buildLevelTable()).
+///
+/// @param singleComponent **true** draws all meter segments in the
+///        meter bar, **false** uses a child component per segment
+///
+void MeterBar::setSingleComponent(
+    bool singleComponent)
+
+{
+    // fast-forward ...
+    if (singleComponent == isSingleComponent_)
+    {
+        return;
+    }
+
+    isSingleComponent_ = singleComponent;
+
+    // move meter segments out of (or back into) the component tree
+    for (int index = 0; index < meterSegments_.size(); ++index)
+    {
+        // get current segment
+        widgets::MeterSegment *segment = meterSegments_[index];
+
+        if (isSingleComponent_)
+        {
+            removeChildComponent(segment);
+            segment->setVisible(false);
+            segment->setEnabled(isEnabled());
+        }
+        else
+        {
+            segment->setEnabled(true);
+            addAndMakeVisible(segment);
+        }
+    }
+
+    repaint();
+}
+
+
 /// Get current segment width.
 ///
 /// @return segment width for vertical meters and segment height for
@@ -565,6 +674,280 @@ void MeterBar::paint(
     // fill background with black (disabled peak markers will be drawn
     // in black)
     g.fillAll(Colours::black);
+
+    // meter segments are child components
+    if (!isSingleComponent_)
+    {
+        return;
+    }
+
+    Rectangle<int> clipBounds = g.getClipBounds();
+
+    // render segment atlas at the display's actual scale factor
+    float scaleFactor = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (!segmentAtlas_.isValid() || (scaleFactor != segmentAtlasScale_))
+    {
+        renderSegmentAtlas(scaleFactor);
+    }
+
+    // levels cannot be looked up, so draw all meter segments that
+    // intersect with the dirty region
+    if (!segmentAtlas_.isValid())
+    {
+        for (int index = 0; index < meterSegments_.size(); ++index)
+        {
+            if (meterSegments_[index]->getBounds().intersects(clipBounds))
+            {
+                paintSegment(g, index);
+            }
+        }
+
+        return;
+    }
+
+    // segments above the normal level are unlit, segments below are
+    // fully lit
+    Range<int> normalSpan = getLevelSpan(normalLevel_);
+    int stripOffset = isEnabled() ? 0 : atlasStrip::unlitAttenuated;
+
+    drawAtlasSpan(g,
+                  Range<int>(0, normalSpan.getStart()),
+                  atlasStrip::unlit + stripOffset);
+
+    drawAtlasSpan(g,
+                  Range<int>(normalSpan.getEnd(), barHeight_),
+                  atlasStrip::lit + stripOffset);
+
+    // all other segments are affected by a level or marker, so draw
+    // them directly
+    Range<int> normalPeakSpan = getLevelSpan(normalLevelPeak_);
+    Range<int> discreteSpan = getLevelSpan(discreteLevel_);
+    Range<int> discretePeakSpan = getLevelSpan(discreteLevelPeak_);
+
+    int numberOfSegments = meterSegments_.size();
+    int firstAffected = -1;
+
+    for (int index = 0; index <= numberOfSegments; ++index)
+    {
+        bool isAffected = false;
+
+        if (index < numberOfSegments)
+        {
+            Range<int> segmentRange = getSegmentRange(index);
+
+            isAffected = segmentRange.intersects(normalSpan) ||
+                         segmentRange.intersects(normalPeakSpan) ||
+                         segmentRange.intersects(discreteSpan) ||
+                         segmentRange.intersects(discretePeakSpan);
+        }
+
+        if (isAffected)
+        {
+            if (firstAffected < 0)
+            {
+                firstAffected = index;
+            }
+
+            continue;
+        }
+
+        // end of a run of affected segments
+        if (firstAffected >= 0)
+        {
+            int lastAffected = index - 1;
+
+            Rectangle<int> runBounds = meterSegments_[firstAffected]->getBounds()
+                                       .getUnion(meterSegments_[lastAffected]->getBounds());
+
+            if (runBounds.intersects(clipBounds))
+            {
+                Graphics::ScopedSaveState savedState(g);
+
+                g.reduceClipRegion(runBounds);
+                g.fillAll(Colours::black);
+
+                // outlines of discrete segments overlap, so paint
+                // neighbouring segments (in their original order)
+                int firstSegment = jmax(firstAffected - 1, 0);
+                int lastSegment = jmin(lastAffected + 1, numberOfSegments - 1);
+
+                for (int segment = firstSegment; segment <= lastSegment; ++segment)
+                {
+                    paintSegment(g, segment);
+                }
+            }
+
+            firstAffected = -1;
+        }
+    }
+}
+
+
+/// Paint a single meter segment.
+///
+/// @param g graphics context
+///
+/// @param index index of meter segment
+///
+void MeterBar::paintSegment(
+    Graphics &g, int index)
+
+{
+    widgets::MeterSegment *segment = meterSegments_[index];
+    Rectangle<int> segmentBounds = segment->getBounds();
+
+    Graphics::ScopedSaveState savedState(g);
+
+    g.setOrigin(segmentBounds.getPosition());
+    g.reduceClipRegion(0, 0,
+                       segmentBounds.getWidth(),
+                       segmentBounds.getHeight());
+
+    segment->paint(g);
+}
+
+
+/// Pre-render the meter bar with all segments unlit and fully lit
+/// (each both normal and attenuated).  The atlas is only rendered
+/// when levels can be looked up.
+///
+/// @param scaleFactor physical pixels per logical pixel
+///
+void MeterBar::renderSegmentAtlas(
+    float scaleFactor)
+
+{
+    segmentAtlas_ = Image();
+    segmentAtlasScale_ = scaleFactor;
+
+    int width = getWidth();
+    int height = getHeight();
+
+    // fast-forward ...
+    if (levelTable_.isEmpty() || (width <= 0) || (height <= 0))
+    {
+        return;
+    }
+
+    int physicalWidth = math::SimpleMath::roundUp(width * scaleFactor);
+    int physicalHeight = math::SimpleMath::roundUp(height * scaleFactor);
+
+    // strips are placed next to each other (across the meter)
+    if (isVertical_)
+    {
+        segmentAtlas_ = Image(Image::RGB,
+                              atlasStrip::numberOfStrips * physicalWidth,
+                              physicalHeight,
+                              true);
+    }
+    else
+    {
+        segmentAtlas_ = Image(Image::RGB,
+                              physicalWidth,
+                              atlasStrip::numberOfStrips * physicalHeight,
+                              true);
+    }
+
+    // levels that lie well below and above all segments
+    float unlitLevel = levelTableMinimum_ - 100.0f;
+    float litLevel = levelTableMinimum_ + 100.0f +
+                     levelTable_.size() * levelTableResolution_;
+
+    for (int strip = 0; strip < atlasStrip::numberOfStrips; ++strip)
+    {
+        bool isLit = (strip == atlasStrip::lit) ||
+                     (strip == atlasStrip::litAttenuated);
+        bool isAttenuated = (strip >= atlasStrip::unlitAttenuated);
+
+        for (int index = 0; index < meterSegments_.size(); ++index)
+        {
+            // get current segment
+            widgets::MeterSegment *segment = meterSegments_[index];
+
+            segment->setEnabled(!isAttenuated);
+            segment->setLevels(isLit ? litLevel : unlitLevel,
+                               unlitLevel, unlitLevel, unlitLevel);
+        }
+
+        Graphics atlasGraphics(segmentAtlas_);
+
+        if (isVertical_)
+        {
+            atlasGraphics.setOrigin(strip * physicalWidth, 0);
+        }
+        else
+        {
+            atlasGraphics.setOrigin(0, strip * physicalHeight);
+        }
+
+        atlasGraphics.addTransform(AffineTransform::scale(scaleFactor));
+        atlasGraphics.reduceClipRegion(0, 0, width, height);
+        atlasGraphics.fillAll(Colours::black);
+
+        for (int index = 0; index < meterSegments_.size(); ++index)
+        {
+            paintSegment(atlasGraphics, index);
+        }
+    }
+
+    // restore meter segments (they do not fade, so this is exact)
+    for (int index = 0; index < meterSegments_.size(); ++index)
+    {
+        // get current segment
+        widgets::MeterSegment *segment = meterSegments_[index];
+
+        segment->setEnabled(isEnabled());
+        segment->setLevels(normalLevel_, normalLevelPeak_,
+                           discreteLevel_, discreteLevelPeak_);
+    }
+}
+
+
+/// Copy pixels along the meter from the segment atlas.
+///
+/// @param g graphics context
+///
+/// @param span pixels (along the meter) to copy
+///
+/// @param strip strip of segment atlas to copy from
+///
+void MeterBar::drawAtlasSpan(
+    Graphics &g, Range<int> span, int strip)
+
+{
+    if (span.isEmpty())
+    {
+        return;
+    }
+
+    Rectangle<int> bounds = getSpanBounds(span);
+
+    int sourceX = math::SimpleMath::round(bounds.getX() * segmentAtlasScale_);
+    int sourceY = math::SimpleMath::round(bounds.getY() * segmentAtlasScale_);
+
+    int sourceWidth = math::SimpleMath::round(
+                          bounds.getWidth() * segmentAtlasScale_);
+    int sourceHeight = math::SimpleMath::round(
+                           bounds.getHeight() * segmentAtlasScale_);
+
+    // select strip
+    if (isVertical_)
+    {
+        sourceX += strip * (segmentAtlas_.getWidth() /
+                            atlasStrip::numberOfStrips);
+    }
+    else
+    {
+        sourceY += strip * (segmentAtlas_.getHeight() /
+                            atlasStrip::numberOfStrips);
+    }
+
+    g.drawImage(segmentAtlas_,
+                bounds.getX(), bounds.getY(),
+                bounds.getWidth(), bounds.getHeight(),
+                sourceX, sourceY,
+                sourceWidth, sourceHeight);
 }
 
 
@@ -572,6 +955,9 @@ void MeterBar::paint(
 ///
 void MeterBar::resized()
 {
+    // segment atlas has to be re-rendered
+    segmentAtlas_ = Image();
+
     // override dimensions of meter bar
     if (isVertical_)
     {
@@ -585,6 +971,321 @@ void MeterBar::resized()
 }
 
 
+/// Called when this component's enablement changes.  Meter segments
+/// that are not child components have to be updated manually.
+///
+void MeterBar::enablementChanged()
+{
+    if (!isSingleComponent_)
+    {
+        return;
+    }
+
+    for (int index = 0; index < meterSegments_.size(); ++index)
+    {
+        // get current segment
+        widgets::MeterSegment *segment = meterSegments_[index];
+
+        segment->setEnabled(isEnabled());
+    }
+
+    repaint();
+}
+
+
+/// Pre-compute which pixels are affected by a given level.  Call
+/// this after all meter segments have been added; setting the
+/// orientation and segment width does not invalidate the table.
+///
+/// Pixels are measured along the meter (from the highest level
+/// downwards), so that the table is independent of orientation.
+/// Without a table, the whole meter bar is repainted on every level
+/// change.
+///
+void MeterBar::buildLevelTable()
+{
+    levelTable_.clear();
+    segmentAtlas_ = Image();
+
+    // fast-forward ...
+    if (meterSegments_.size() == 0)
+    {
+        return;
+    }
+
+    float minimumLevel = segmentLevelRanges_[0].getStart();
+    float maximumLevel = segmentLevelRanges_[0].getEnd();
+
+    for (int index = 0; index < meterSegments_.size(); ++index)
+    {
+        Range<float> levelRange = segmentLevelRanges_[index];
+
+        // level range of segment is unknown, so levels cannot be
+        // looked up
+        if (levelRange.isEmpty())
+        {
+            return;
+        }
+
+        minimumLevel = jmin(minimumLevel, levelRange.getStart());
+        maximumLevel = jmax(maximumLevel, levelRange.getEnd());
+    }
+
+    levelTableMinimum_ = minimumLevel;
+
+    int numberOfEntries = math::SimpleMath::roundUp(
+                              (maximumLevel - minimumLevel) /
+                              levelTableResolution_);
+
+    levelTable_.ensureStorageAllocated(numberOfEntries);
+
+    for (int entry = 0; entry < numberOfEntries; ++entry)
+    {
+        // every entry covers all levels from its lower to its upper
+        // level; as levels map monotonically to pixels, it is
+        // sufficient to look at both ends
+        float lowerLevel = minimumLevel + entry * levelTableResolution_;
+        float upperLevel = lowerLevel + 0.999f * levelTableResolution_;
+
+        Range<int> span;
+
+        for (int index = 0; index < meterSegments_.size(); ++index)
+        {
+            Range<float> levelRange = segmentLevelRanges_[index];
+
+            // segment does not display any of these levels
+            if ((upperLevel < levelRange.getStart()) ||
+                    (lowerLevel >= levelRange.getEnd()))
+            {
+                continue;
+            }
+
+            Range<int> lowerSpan = getSegmentSpan(index, lowerLevel);
+            Range<int> upperSpan = getSegmentSpan(index, upperLevel);
+
+            if (span.isEmpty())
+            {
+                span = lowerSpan.getUnionWith(upperSpan);
+            }
+            else
+            {
+                span = span.getUnionWith(lowerSpan).getUnionWith(upperSpan);
+            }
+        }
+
+        levelTable_.add(span);
+    }
+}
+
+
+/// Get pixels (along the meter) that are affected when a meter
+/// segment displays the given level.
+///
+/// @param index index of meter segment
+///
+/// @param level level (in decibels)
+///
+/// @return affected pixels (along the meter)
+///
+Range<int> MeterBar::getSegmentSpan(
+    int index, float level)
+
+{
+    Range<int> segmentRange = getSegmentRange(index);
+
+    int segmentStart = segmentRange.getStart();
+    int segmentLength = segmentRange.getLength();
+
+    Range<int> meterRange(0, barHeight_);
+
+    // discrete segments light up as a whole, and their outlines
+    // overlap neighbouring segments
+    if (!segmentIsContinuous_[index])
+    {
+        return Range<int>(segmentStart - 1,
+                          segmentStart + segmentLength + 1)
+               .getIntersectionWith(meterRange);
+    }
+
+    Range<float> levelRange = segmentLevelRanges_[index];
+
+    float levelPosition = (level - levelRange.getStart()) /
+                          levelRange.getLength();
+    levelPosition = jlimit(0.0f, 1.0f, levelPosition);
+
+    int pixel = segmentStart + math::SimpleMath::round(
+                    (segmentLength - 1) * (1.0f - levelPosition));
+
+    // level markers are two pixels high and may overlap into the
+    // neighbouring segment
+    return Range<int>(pixel - 2, pixel + 3)
+           .getIntersectionWith(meterRange);
+}
+
+
+/// Get pixels (along the meter) that are covered by a meter segment.
+///
+/// @param index index of meter segment
+///
+/// @return covered pixels (along the meter)
+///
+Range<int> MeterBar::getSegmentRange(
+    int index)
+
+{
+    widgets::MeterSegment *segment = meterSegments_[index];
+    Rectangle<int> segmentBounds = segment->getBounds();
+
+    int segmentStart;
+    int segmentLength;
+
+    if (isVertical_)
+    {
+        segmentStart = segmentBounds.getY();
+        segmentLength = segmentBounds.getHeight();
+    }
+    // horizontal meter: swap x <=> y
+    else
+    {
+        segmentStart = segmentBounds.getX();
+        segmentLength = segmentBounds.getWidth();
+    }
+
+    // measure from the highest level downwards
+    if (isInverted_)
+    {
+        segmentStart = barHeight_ - segmentStart - segmentLength;
+    }
+
+    return Range<int>(segmentStart, segmentStart + segmentLength);
+}
+
+
+/// Look up pixels (along the meter) that are affected by a level.
+///
+/// @param level level (in decibels)
+///
+/// @return affected pixels (along the meter)
+///
+Range<int> MeterBar::getLevelSpan(
+    float level)
+
+{
+    int entry = math::SimpleMath::roundDown(
+                    (level - levelTableMinimum_) / levelTableResolution_);
+
+    // levels outside of the table are displayed by the lowest or
+    // highest segment
+    entry = jlimit(0, levelTable_.size() - 1, entry);
+
+    return levelTable_.getUnchecked(entry);
+}
+
+
+/// Convert pixels along the meter to component coordinates.
+///
+/// @param span pixels (along the meter)
+///
+/// @return bounds of pixels within the meter bar
+///
+Rectangle<int> MeterBar::getSpanBounds(
+    Range<int> span)
+
+{
+    int start = span.getStart();
+
+    // convert back from "highest level first"
+    if (isInverted_)
+    {
+        start = barHeight_ - span.getEnd();
+    }
+
+    if (isVertical_)
+    {
+        return Rectangle<int>(0, start, getWidth(), span.getLength());
+    }
+    // horizontal meter: swap x <=> y
+    else
+    {
+        return Rectangle<int>(start, 0, span.getLength(), getHeight());
+    }
+}
+
+
+/// Repaint pixels along the meter.
+///
+/// @param span pixels (along the meter) to repaint
+///
+void MeterBar::repaintSpan(
+    Range<int> span)
+
+{
+    if (span.isEmpty())
+    {
+        return;
+    }
+
+    repaint(getSpanBounds(span));
+}
+
+
+/// Repaint those parts of the meter bar that are affected by a
+/// change in levels.  Does nothing unless the meter bar is in
+/// single-component mode.
+///
+/// @param normalLevelOld old normal level
+///
+/// @param normalLevelPeakOld old normal peak level
+///
+/// @param discreteLevelOld old discrete level
+///
+/// @param discreteLevelPeakOld old discrete peak level
+///
+void MeterBar::repaintLevelChanges(
+    float normalLevelOld, float normalLevelPeakOld,
+    float discreteLevelOld, float discreteLevelPeakOld)
+
+{
+    if (!isSingleComponent_)
+    {
+        return;
+    }
+
+    // levels cannot be looked up
+    if (levelTable_.isEmpty())
+    {
+        repaint();
+        return;
+    }
+
+    // the bar changes everywhere between old and new level
+    if (normalLevel_ != normalLevelOld)
+    {
+        repaintSpan(getLevelSpan(normalLevelOld).getUnionWith(
+                        getLevelSpan(normalLevel_)));
+    }
+
+    // markers only change at their old and new position
+    if (normalLevelPeak_ != normalLevelPeakOld)
+    {
+        repaintSpan(getLevelSpan(normalLevelPeakOld));
+        repaintSpan(getLevelSpan(normalLevelPeak_));
+    }
+
+    if (discreteLevel_ != discreteLevelOld)
+    {
+        repaintSpan(getLevelSpan(discreteLevelOld));
+        repaintSpan(getLevelSpan(discreteLevel_));
+    }
+
+    if (discreteLevelPeak_ != discreteLevelPeakOld)
+    {
+        repaintSpan(getLevelSpan(discreteLevelPeakOld));
+        repaintSpan(getLevelSpan(discreteLevelPeak_));
+    }
+}
+
+
 /// Set normal (average) levels.  Use this only if you completely
 /// disregard discrete (peak) levels!
 ///
@@ -600,6 +1301,9 @@ void MeterBar::setNormalLevels(
     if ((normalLevel_ != normalLevel) ||
             (normalLevelPeak_ != normalLevelPeak))
     {
+        float normalLevelOld = normalLevel_;
+        float normalLevelPeakOld = normalLevelPeak_;
+
         // update levels
         normalLevel_ = normalLevel;
         normalLevelPeak_ = normalLevelPeak;
@@ -613,6 +1317,9 @@ void MeterBar::setNormalLevels(
             segment->setNormalLevels(
                 normalLevel_, normalLevelPeak_);
         }
+
+        repaintLevelChanges(normalLevelOld, normalLevelPeakOld,
+                            discreteLevel_, discreteLevelPeak_);
     }
 }
 
@@ -632,6 +1339,9 @@ void MeterBar::setDiscreteLevels(
     if ((discreteLevel_ != discreteLevel) ||
             (discreteLevelPeak_ != discreteLevelPeak))
     {
+        float discreteLevelOld = discreteLevel_;
+        float discreteLevelPeakOld = discreteLevelPeak_;
+
         // update levels
         discreteLevel_ = discreteLevel;
         discreteLevelPeak_ = discreteLevelPeak;
@@ -645,6 +1355,9 @@ void MeterBar::setDiscreteLevels(
             segment->setDiscreteLevels(
                 discreteLevel_, discreteLevelPeak_);
         }
+
+        repaintLevelChanges(normalLevel_, normalLevelPeak_,
+                            discreteLevelOld, discreteLevelPeakOld);
     }
 }
 
@@ -670,6 +1383,11 @@ void MeterBar::setLevels(
             (discreteLevel_ != discreteLevel) ||
             (discreteLevelPeak_ != discreteLevelPeak))
     {
+        float normalLevelOld = normalLevel_;
+        float normalLevelPeakOld = normalLevelPeak_;
+        float discreteLevelOld = discreteLevel_;
+        float discreteLevelPeakOld = discreteLevelPeak_;
+
         // update "normal" levels
         normalLevel_ = normalLevel;
         normalLevelPeak_ = normalLevelPeak;
@@ -688,6 +1406,9 @@ void MeterBar::setLevels(
                 normalLevel_, normalLevelPeak_,
                 discreteLevel_, discreteLevelPeak_);
         }
+
+        repaintLevelChanges(normalLevelOld, normalLevelPeakOld,
+                            discreteLevelOld, discreteLevelPeakOld);
     }
 }
 
@@ -35,6 +35,12 @@ namespace widgets
 /// be filled with meter segment widgets.  These can then be
 /// comfortably updated with a single function call.
 ///
+/// In single-component mode, the meter segments are not added as
+/// child components.  Instead, the meter bar draws all segments in
+/// its own paint() and only repaints the pixels that are affected by
+/// a level change.  Unlit and fully lit segments are pre-rendered
+/// into an atlas at the display's scale factor and simply copied.
+///
 /// @see MeterSegment
 ///
 class MeterBar :
@@ -74,6 +80,9 @@ public:
     virtual void invertMeter(bool invert);
     virtual bool isMeterInverted();
 
+    virtual bool isSingleComponent();
+    virtual void setSingleComponent(bool singleComponent);
+
     virtual int getSegmentWidth();
     virtual void setSegmentWidth(int segmentWidth);
 
@@ -90,10 +99,59 @@ public:
 
     virtual void paint(Graphics &g);
     virtual void resized();
+    virtual void enablementChanged();
+
+protected:
+    virtual void buildLevelTable();
+
+    /// Strips of pre-rendered meter bars in segment atlas.
+    enum atlasStrip  // protected namespace
+    {
+        /// all segments unlit
+        unlit = 0,
+
+        /// all segments fully lit
+        lit,
+
+        /// all segments unlit and attenuated
+        unlitAttenuated,
+
+        /// all segments fully lit and attenuated
+        litAttenuated,
+
+        /// number of strips
+        numberOfStrips
+    };
 
 private:
     JUCE_LEAK_DETECTOR(MeterBar);
 
+    void paintSegment(Graphics &g,
+                      int index);
+
+    void renderSegmentAtlas(float scaleFactor);
+
+    void drawAtlasSpan(Graphics &g,
+                       Range<int> span,
+                       int strip);
+
+    Range<int> getSegmentRange(int index);
+    Rectangle<int> getSpanBounds(Range<int> span);
+
+    Range<int> getSegmentSpan(int index,
+                              float level);
+
+    Range<int> getLevelSpan(float level);
+
+    void repaintSpan(Range<int> span);
+
+    void repaintLevelChanges(float normalLevelOld,
+                             float normalLevelPeakOld,
+                             float discreteLevelOld,
+                             float discreteLevelPeakOld);
+
+    const float levelTableResolution_;
+
     float normalLevel_;
     float normalLevelPeak_;
 
@@ -106,10 +164,25 @@ private:
 
     bool isVertical_;
     bool isInverted_;
+    bool isSingleComponent_;
+
+    float levelTableMinimum_;
 
     widgets::Orientation orientation_;
     Array<int> segmentSpacing_;
     OwnedArray<widgets::MeterSegment> meterSegments_;
+
+    // level ranges are empty for segments that cannot be looked up
+    Array<Range<float>> segmentLevelRanges_;
+    Array<bool> segmentIsContinuous_;
+
+    // pixels (along the meter) that are affected by a level, indexed
+    // in steps of "levelTableResolution_" decibels
+    Array<Range<int>> levelTable_;
+
+    // pre-rendered meter bar strips (in physical pixels)
+    Image segmentAtlas_;
+    float segmentAtlasScale_;
 };
 
 }
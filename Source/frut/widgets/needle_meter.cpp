@@ -48,6 +48,9 @@ NeedleMeter::NeedleMeter()
 
     // initialise meter orientation
     isVerticalMeter_ = false;
+
+    // initialise needle atlas
+    needleAtlasScale_ = 1.0f;
 }
 
 
@@ -59,17 +62,211 @@ void NeedleMeter::paint(
     Graphics &g)
 
 {
-    // draw background image
-    g.drawImageAt(imageBackground_, 0, 0, false);
+    // render needle atlas at the display's actual scale factor
+    float scaleFactor = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (!needleAtlas_.isValid() || (scaleFactor != needleAtlasScale_))
+    {
+        renderNeedleAtlas(scaleFactor);
+    }
+
+    int needleBand = needlePosition_;
 
-    // draw needle according to orientation
     if (isVerticalMeter_)
     {
-        g.drawImageAt(imageNeedle_, needleSpacingLeft_, needlePosition_, false);
+        needleBand -= needleSpacingTop_;
     }
     else
     {
-        g.drawImageAt(imageNeedle_, needlePosition_, needleSpacingTop_, false);
+        needleBand -= needleSpacingLeft_;
+    }
+
+    // needle lies outside of its travel path (or atlas could not be
+    // rendered), so draw images directly
+    if (!needleAtlas_.isValid() ||
+            (needleBand < 0) || (needleBand > needleTravelPath_))
+    {
+        // draw background image
+        g.drawImageAt(imageBackground_, 0, 0, false);
+
+        // draw needle according to orientation
+        if (isVerticalMeter_)
+        {
+            g.drawImageAt(imageNeedle_, needleSpacingLeft_, needlePosition_, false);
+        }
+        else
+        {
+            g.drawImageAt(imageNeedle_, needlePosition_, needleSpacingTop_, false);
+        }
+
+        return;
+    }
+
+    int width = getWidth();
+    int height = getHeight();
+
+    int physicalWidth = math::SimpleMath::roundUp(width * needleAtlasScale_);
+    int physicalHeight = math::SimpleMath::roundUp(height * needleAtlasScale_);
+
+    // copy background
+    g.drawImage(needleAtlas_,
+                0, 0, width, height,
+                0, 0, physicalWidth, physicalHeight);
+
+    // copy band with needle (bands are placed next to the background)
+    Rectangle<int> needleBounds = getNeedleBounds(needlePosition_);
+
+    int physicalBandWidth = math::SimpleMath::roundUp(
+                                needleBounds.getWidth() * needleAtlasScale_);
+    int physicalBandHeight = math::SimpleMath::roundUp(
+                                 needleBounds.getHeight() * needleAtlasScale_);
+
+    if (isVerticalMeter_)
+    {
+        g.drawImage(needleAtlas_,
+                    needleBounds.getX(), needleBounds.getY(),
+                    needleBounds.getWidth(), needleBounds.getHeight(),
+                    physicalWidth, needleBand * physicalBandHeight,
+                    physicalBandWidth, physicalBandHeight);
+    }
+    else
+    {
+        g.drawImage(needleAtlas_,
+                    needleBounds.getX(), needleBounds.getY(),
+                    needleBounds.getWidth(), needleBounds.getHeight(),
+                    needleBand * physicalBandWidth, physicalHeight,
+                    physicalBandWidth, physicalBandHeight);
+    }
+}
+
+
+/// Pre-render background and needle bands.  Every needle position
+/// on the travel path gets a band (background with needle) that
+/// spans the meter's height (or width for vertical meters).
+///
+/// @param scaleFactor physical pixels per logical pixel
+///
+void NeedleMeter::renderNeedleAtlas(
+    float scaleFactor)
+
+{
+    needleAtlas_ = Image();
+    needleAtlasScale_ = scaleFactor;
+
+    int width = getWidth();
+    int height = getHeight();
+
+    // fast-forward ...
+    if (!imageBackground_.isValid() || !imageNeedle_.isValid() ||
+            (width <= 0) || (height <= 0) || (needleTravelPath_ < 0))
+    {
+        return;
+    }
+
+    int numberOfBands = needleTravelPath_ + 1;
+
+    int physicalWidth = math::SimpleMath::roundUp(width * scaleFactor);
+    int physicalHeight = math::SimpleMath::roundUp(height * scaleFactor);
+
+    Rectangle<int> bandBounds = getNeedleBounds(0);
+
+    int physicalBandWidth = math::SimpleMath::roundUp(
+                                bandBounds.getWidth() * scaleFactor);
+    int physicalBandHeight = math::SimpleMath::roundUp(
+                                 bandBounds.getHeight() * scaleFactor);
+
+    // bands are placed next to the background
+    if (isVerticalMeter_)
+    {
+        needleAtlas_ = Image(Image::RGB,
+                             physicalWidth + physicalBandWidth,
+                             jmax(physicalHeight,
+                                  numberOfBands * physicalBandHeight),
+                             true);
+    }
+    else
+    {
+        needleAtlas_ = Image(Image::RGB,
+                             jmax(physicalWidth,
+                                  numberOfBands * physicalBandWidth),
+                             physicalHeight + physicalBandHeight,
+                             true);
+    }
+
+    // render background (high-quality scaling happens only once)
+    {
+        Graphics atlasGraphics(needleAtlas_);
+
+        atlasGraphics.addTransform(AffineTransform::scale(scaleFactor));
+        atlasGraphics.reduceClipRegion(0, 0, width, height);
+        atlasGraphics.setImageResamplingQuality(
+            Graphics::highResamplingQuality);
+
+        atlasGraphics.drawImageAt(imageBackground_, 0, 0, false);
+    }
+
+    // render bands
+    for (int band = 0; band < numberOfBands; ++band)
+    {
+        Graphics atlasGraphics(needleAtlas_);
+
+        int needlePosition;
+
+        if (isVerticalMeter_)
+        {
+            needlePosition = band + needleSpacingTop_;
+            atlasGraphics.setOrigin(physicalWidth,
+                                    band * physicalBandHeight);
+        }
+        else
+        {
+            needlePosition = band + needleSpacingLeft_;
+            atlasGraphics.setOrigin(band * physicalBandWidth,
+                                    physicalHeight);
+        }
+
+        Rectangle<int> needleBounds = getNeedleBounds(needlePosition);
+
+        atlasGraphics.addTransform(AffineTransform::scale(scaleFactor));
+        atlasGraphics.setOrigin(-needleBounds.getX(), -needleBounds.getY());
+        atlasGraphics.reduceClipRegion(needleBounds);
+        atlasGraphics.setImageResamplingQuality(
+            Graphics::highResamplingQuality);
+
+        atlasGraphics.drawImageAt(imageBackground_, 0, 0, false);
+
+        if (isVerticalMeter_)
+        {
+            atlasGraphics.drawImageAt(imageNeedle_, needleSpacingLeft_, needlePosition, false);
+        }
+        else
+        {
+            atlasGraphics.drawImageAt(imageNeedle_, needlePosition, needleSpacingTop_, false);
+        }
+    }
+}
+
+
+/// Get the band that is covered by the needle.
+///
+/// @param needlePosition position of needle
+///
+/// @return band covered by the needle (spans the meter's height or
+///         width for vertical meters)
+///
+Rectangle<int> NeedleMeter::getNeedleBounds(
+    int needlePosition)
+
+{
+    if (isVerticalMeter_)
+    {
+        return Rectangle<int>(0, needlePosition,
+                              getWidth(), imageNeedle_.getHeight());
+    }
+    else
+    {
+        return Rectangle<int>(needlePosition, 0,
+                              imageNeedle_.getWidth(), getHeight());
     }
 }
 
@@ -97,6 +294,9 @@ void NeedleMeter::resized()
         needleTravelPath_ = width - 2 * needleSpacingLeft_;
         needleTravelPath_ -= imageNeedle_.getWidth();
     }
+
+    // needle atlas has to be re-rendered
+    needleAtlas_ = Image();
 }
 
 
@@ -123,10 +323,12 @@ void NeedleMeter::setValue(
         needlePosition_ += needleSpacingLeft_;
     }
 
-    // update of needle position is necessary
+    // update of needle position is necessary; only repaint the
+    // bands of the old and new needle position
     if (needlePosition_ != needlePositionOld)
     {
-        repaint(getLocalBounds());
+        repaint(getNeedleBounds(needlePositionOld));
+        repaint(getNeedleBounds(needlePosition_));
     }
 }
 
@@ -150,9 +352,10 @@ void NeedleMeter::setImages(
     int needleSpacingTop)
 
 {
-    // update images (creates a copy of each image)
-    imageBackground_ = imageBackground.createCopy();
-    imageNeedle_ = imageNeedle.createCopy();
+    // update images (images are never drawn into, so they can be
+    // shared)
+    imageBackground_ = imageBackground;
+    imageNeedle_ = imageNeedle;
 
     // update needle spacing
     needleSpacingLeft_ = needleSpacingLeft;
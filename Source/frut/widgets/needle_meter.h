@@ -32,6 +32,9 @@ namespace widgets
 {
 
 /// Meter component with a needle that moves according to the input.
+/// The background and the needle at every position are pre-rendered
+/// into an atlas at the display's scale factor, so that painting the
+/// meter only copies pixels.
 ///
 class NeedleMeter :
     public Component
@@ -50,6 +53,9 @@ public:
     virtual void resized();
 
 protected:
+    void renderNeedleAtlas(float scaleFactor);
+    Rectangle<int> getNeedleBounds(int needlePosition);
+
     int needlePosition_;
     int needleTravelPath_;
     bool isVerticalMeter_;
@@ -60,6 +66,11 @@ protected:
     Image imageBackground_;
     Image imageNeedle_;
 
+    // background followed by a band for every needle position (in
+    // physical pixels)
+    Image needleAtlas_;
+    float needleAtlasScale_;
+
 private:
     JUCE_LEAK_DETECTOR(NeedleMeter);
 };
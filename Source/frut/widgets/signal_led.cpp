@@ -112,10 +112,11 @@ void SignalLed::setImages(
     const Image &imageHigh)
 
 {
-    // update images (creates a copy of each image)
-    imageOff_ = imageOff.createCopy();
-    imageLow_ = imageLow.createCopy();
-    imageHigh_ = imageHigh.createCopy();
+    // update images (images are never drawn into, so they can be
+    // shared)
+    imageOff_ = imageOff;
+    imageLow_ = imageLow;
+    imageHigh_ = imageHigh;
 
     // assert that all images have the same size
     jassert(imageOff_.getBounds() == imageLow_.getBounds());
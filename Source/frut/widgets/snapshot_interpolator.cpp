@@ -0,0 +1,188 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+namespace frut
+{
+namespace widgets
+{
+
+// limits of the interval between snapshots (in milliseconds); long
+// gaps (such as stopped playback) must not slow down the animation
+const double SnapshotInterpolator::minimumInterval_ = 5.0;
+const double SnapshotInterpolator::maximumInterval_ = 100.0;
+
+
+/// Create a new interpolator without any values.
+///
+SnapshotInterpolator::SnapshotInterpolator() :
+    snapshotTime_(0.0),
+    frameTime_(0.0),
+    snapshotInterval_(maximumInterval_)
+{
+}
+
+
+/// Set number of values and set all values to an initial value.
+///
+/// @param numberOfValues number of values
+///
+/// @param initialValue initial value
+///
+void SnapshotInterpolator::reset(
+    int numberOfValues,
+    float initialValue)
+
+{
+    jassert(numberOfValues >= 0);
+
+    startValues_.clearQuick();
+    targetValues_.clearQuick();
+    currentValues_.clearQuick();
+
+    startValues_.insertMultiple(0, initialValue, numberOfValues);
+    targetValues_.insertMultiple(0, initialValue, numberOfValues);
+    currentValues_.insertMultiple(0, initialValue, numberOfValues);
+
+    snapshotTime_ = Time::getMillisecondCounterHiRes();
+    frameTime_ = snapshotTime_;
+}
+
+
+/// Get number of values.
+///
+/// @return number of values
+///
+int SnapshotInterpolator::getNumberOfValues() const
+{
+    return currentValues_.size();
+}
+
+
+/// Start a new snapshot.  Interpolation continues from the values
+/// that are currently displayed.  Call setTarget() for every value
+/// afterwards.
+///
+void SnapshotInterpolator::beginSnapshot()
+{
+    // snapshots are usually polled on frames, so the snapshot
+    // arrived some time after the last frame; otherwise, values
+    // would not move on frames that receive a snapshot
+    double arrivalTime = frameTime_;
+
+    if (arrivalTime <= snapshotTime_)
+    {
+        arrivalTime = Time::getMillisecondCounterHiRes();
+    }
+
+    double interval = jlimit(minimumInterval_,
+                             maximumInterval_,
+                             arrivalTime - snapshotTime_);
+
+    // single intervals jitter by up to one frame
+    snapshotInterval_ += 0.25 * (interval - snapshotInterval_);
+    snapshotTime_ = arrivalTime;
+
+    startValues_ = currentValues_;
+}
+
+
+/// Set value of current snapshot.
+///
+/// @param index index of value
+///
+/// @param target new value
+///
+/// @param immediateRise if **true**, rising values are displayed
+///        immediately
+///
+void SnapshotInterpolator::setTarget(
+    int index,
+    float target,
+    bool immediateRise)
+
+{
+    jassert(isPositiveAndBelow(index, currentValues_.size()));
+
+    targetValues_.set(index, target);
+
+    if (immediateRise && (target > currentValues_[index]))
+    {
+        startValues_.set(index, target);
+        currentValues_.set(index, target);
+    }
+}
+
+
+/// Update values for the current frame.
+///
+/// @return **true** if values are still moving towards the current
+///         snapshot
+///
+bool SnapshotInterpolator::advance()
+{
+    frameTime_ = Time::getMillisecondCounterHiRes();
+
+    double elapsed = frameTime_ - snapshotTime_;
+    float progress = static_cast<float>(
+                         jlimit(0.0, 1.0, elapsed / snapshotInterval_));
+
+    for (int index = 0; index < currentValues_.size(); ++index)
+    {
+        float startValue = startValues_[index];
+        float targetValue = targetValues_[index];
+
+        currentValues_.set(index, startValue +
+                           progress * (targetValue - startValue));
+    }
+
+    return progress < 1.0f;
+}
+
+
+/// Jump to the values of the current snapshot (for example, when
+/// rendering offline).
+///
+void SnapshotInterpolator::skip()
+{
+    startValues_ = targetValues_;
+    currentValues_ = targetValues_;
+}
+
+
+/// Get value for the current frame.
+///
+/// @param index index of value
+///
+/// @return interpolated value
+///
+float SnapshotInterpolator::getValue(
+    int index) const
+
+{
+    return currentValues_[index];
+}
+
+}
+}
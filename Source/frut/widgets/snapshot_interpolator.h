@@ -0,0 +1,82 @@
+/* ----------------------------------------------------------------------------
+
+   FrutJUCE
+   ========
+   Common classes for use with the JUCE library
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef FRUT_WIDGETS_SNAPSHOT_INTERPOLATOR_H
+#define FRUT_WIDGETS_SNAPSHOT_INTERPOLATOR_H
+
+namespace frut
+{
+namespace widgets
+{
+
+/// Animates meter readings at display rate.  Readings arrive as
+/// snapshots at the rate of the audio processing (and often with
+/// jitter), but should be displayed on every frame.  This class
+/// interpolates linearly from the values that were displayed when
+/// the last snapshot arrived to the values of that snapshot, and
+/// spreads the movement over the (smoothed) interval between
+/// snapshots.
+///
+/// Values that are marked for immediate rise skip interpolation
+/// when rising, so that peaks are displayed without delay.
+///
+class SnapshotInterpolator
+{
+public:
+    SnapshotInterpolator();
+
+    void reset(int numberOfValues,
+               float initialValue);
+
+    int getNumberOfValues() const;
+
+    void beginSnapshot();
+    void setTarget(int index,
+                   float target,
+                   bool immediateRise);
+
+    bool advance();
+    void skip();
+    float getValue(int index) const;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SnapshotInterpolator);
+
+    static const double minimumInterval_;
+    static const double maximumInterval_;
+
+    Array<float> startValues_;
+    Array<float> targetValues_;
+    Array<float> currentValues_;
+
+    double snapshotTime_;
+    double frameTime_;
+    double snapshotInterval_;
+};
+
+}
+}
+
+#endif  // FRUT_WIDGETS_SNAPSHOT_INTERPOLATOR_H
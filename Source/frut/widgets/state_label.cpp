@@ -171,14 +171,18 @@ void StateLabel::setImages(
     textColourOn_ = Colour::fromString("ff" + textColourOn);
     textColourActive_ = Colour::fromString("ff" + textColourActive);
 
-    // update images (creates a copy of each image)
-    imageOff_ = imageOff.createCopy();
-    imageOn_ = imageOn.createCopy();
-    imageActive_ = imageActive.createCopy();
+    // update images (images are shared unless they are drawn into)
+    imageOff_ = imageOff;
+    imageOn_ = imageOn;
+    imageActive_ = imageActive;
 
     // attenuate colours if label is disabled
     if (!isEnabled())
     {
+        imageOff_ = imageOff.createCopy();
+        imageOn_ = imageOn.createCopy();
+        imageActive_ = imageActive.createCopy();
+
         Graphics g1(imageOff_);
         g1.setColour(attenuatedColour_);
         g1.fillAll();
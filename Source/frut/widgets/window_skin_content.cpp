@@ -241,7 +241,7 @@ void WindowSkinContent::buttonClicked(
 /// Create a list box model for a WindowSkinContent.
 ///
 SkinListBoxModel::SkinListBoxModel()
-    : skinWildcard_("*.skin", String(), "Skin files"),
+    : skinWildcard_("*.skin;*.skinbundle", String(), "Skin files"),
       directoryThread_("Skin directory scanner")
 {
 }
@@ -294,8 +294,9 @@ void SkinListBoxModel::fill(
         // get file name without extension
         String skinName = skinFile.getFileNameWithoutExtension();
 
-        // add skin name to internal array
-        skinNames_.add(skinName);
+        // add skin name to internal array (compiled skins usually
+        // sit next to their source)
+        skinNames_.addIfNotAlreadyThere(skinName);
     }
 }
 
@@ -26,20 +26,56 @@
 #include "kmeter.h"
 
 void Kmeter::create(
-    int numberOfInputChannels)
+    const AudioChannelSet &channelSet)
 
 {
     // this component blends in with the background
     setOpaque(false);
 
+    displayPeakMeter_ = false;
+
+    // built meters can be re-used as long as the channel layout
+    // stays the same
+    if (channelSet == channelSet_)
+    {
+        return;
+    }
+
     // clear old meters and peak labels
     levelMeters_.clear();
+    meterBarLayouts_.clear();
+    meterBarCache_.clear();
+
     overflowMeters_.clear();
     maximumPeakLabels_.clear();
     maximumTruePeakLabels_.clear();
 
-    numberOfInputChannels_ = numberOfInputChannels;
-    displayPeakMeter_ = false;
+    channelSet_ = channelSet;
+    numberOfInputChannels_ = channelSet.size();
+
+    segmentHeight_ = 0;
+    segmentColours_.clear();
+
+    levelAnimation_.reset(numberOfInputChannels_ * numberOfAnimatedReadings,
+                          MeterBallistics::getMeterMinimumDecibel());
+}
+
+
+// Returns a unique key for every scale layout of the meter bars.
+int Kmeter::getLayoutKey(
+    int crestFactor,
+    bool discreteMeter,
+    bool isExpanded,
+    bool isHorizontal)
+
+{
+    int layoutKey = crestFactor;
+
+    layoutKey = (layoutKey << 1) | (discreteMeter ? 1 : 0);
+    layoutKey = (layoutKey << 1) | (isExpanded ? 1 : 0);
+    layoutKey = (layoutKey << 1) | (isHorizontal ? 1 : 0);
+
+    return layoutKey;
 }
 
 
@@ -94,133 +130,139 @@ void Kmeter::applySkin(
     segmentColours.add(segmentGreen);
     segmentColours.add(segmentNonLinear);
 
-    levelMeters_.clear();
-    overflowMeters_.clear();
-    maximumPeakLabels_.clear();
-    maximumTruePeakLabels_.clear();
+    // meter bars depend on these settings, so switching skins
+    // invalidates all built scale layouts
+    if ((segmentHeight != segmentHeight_) ||
+            (segmentColours != segmentColours_))
+    {
+        levelMeters_.clear();
+        meterBarLayouts_.clear();
+        meterBarCache_.clear();
 
-    for (int channel = 0; channel < numberOfInputChannels_; ++channel)
+        segmentHeight_ = segmentHeight;
+        segmentColours_ = segmentColours;
+    }
+
+    // building meter bars is expensive, so every scale layout is
+    // built only once; switching layouts merely changes which meter
+    // bars are visible
+    int layoutKey = getLayoutKey(crestFactor,
+                                 discreteMeter,
+                                 isExpanded,
+                                 isHorizontal);
+
+    if (!meterBarLayouts_.contains(layoutKey))
     {
-        MeterBar *meterBar = levelMeters_.add(new MeterBar());
+        meterBarLayouts_.set(layoutKey, meterBarCache_.size());
 
-        meterBar->create(crestFactor,
-                         discreteMeter,
-                         isExpanded,
-                         orientation,
-                         segmentHeight,
-                         segmentColours);
+        for (int channel = 0; channel < numberOfInputChannels_; ++channel)
+        {
+            MeterBar *meterBar = meterBarCache_.add(new MeterBar());
 
-        meterBar->setEnabled(isEnabled());
+            meterBar->create(crestFactor,
+                             discreteMeter,
+                             isExpanded,
+                             orientation,
+                             segmentHeight,
+                             segmentColours);
 
-        addAndMakeVisible(meterBar);
+            meterBar->setEnabled(isEnabled());
 
-        OverflowMeter *overflowMeter = overflowMeters_.add(
-                                           new OverflowMeter());
-        addAndMakeVisible(overflowMeter);
+            // keep overflow meters and peak labels on top
+            addChildComponent(meterBar, 0);
+        }
+    }
 
-        PeakLabel *peakLabel = maximumPeakLabels_.add(
-                                   new PeakLabel(crestFactor));
+    int firstMeterBar = meterBarLayouts_[layoutKey];
 
-        addAndMakeVisible(peakLabel);
+    for (int index = 0; index < meterBarCache_.size(); ++index)
+    {
+        bool isCurrentLayout = (index >= firstMeterBar) &&
+                               (index < firstMeterBar + numberOfInputChannels_);
 
-        PeakLabel *truePeakLabel = maximumTruePeakLabels_.add(
-                                       new PeakLabel(crestFactor));
+        meterBarCache_[index]->setVisible(isCurrentLayout);
+    }
+
+    levelMeters_.clear();
 
-        addAndMakeVisible(truePeakLabel);
+    for (int channel = 0; channel < numberOfInputChannels_; ++channel)
+    {
+        levelMeters_.add(meterBarCache_[firstMeterBar + channel]);
     }
 
-    if (numberOfInputChannels_ == 1)
+    // overflow meters and peak labels only depend on the channel
+    // layout
+    if (overflowMeters_.isEmpty())
     {
-        skin->placeMeterBar("meter_kmeter",
-                            levelMeters_[0]);
-        skin->placeAndSkinStateLabel("label_over",
-                                     overflowMeters_[0]);
-        skin->placeAndSkinStateLabel("label_peak",
-                                     maximumPeakLabels_[0]);
-        skin->placeAndSkinStateLabel("label_true_peak",
-                                     maximumTruePeakLabels_[0]);
+        for (int channel = 0; channel < numberOfInputChannels_; ++channel)
+        {
+            OverflowMeter *overflowMeter = overflowMeters_.add(
+                                               new OverflowMeter());
+            addAndMakeVisible(overflowMeter);
+
+            PeakLabel *peakLabel = maximumPeakLabels_.add(
+                                       new PeakLabel(crestFactor));
+
+            addAndMakeVisible(peakLabel);
+
+            PeakLabel *truePeakLabel = maximumTruePeakLabels_.add(
+                                           new PeakLabel(crestFactor));
+
+            addAndMakeVisible(truePeakLabel);
+        }
     }
-    else if (numberOfInputChannels_ == 2)
+    else
     {
-        skin->placeMeterBar("meter_kmeter_left",
-                            levelMeters_[0]);
-        skin->placeAndSkinStateLabel("label_over_left",
-                                     overflowMeters_[0]);
-        skin->placeAndSkinStateLabel("label_peak_left",
-                                     maximumPeakLabels_[0]);
-        skin->placeAndSkinStateLabel("label_true_peak_left",
-                                     maximumTruePeakLabels_[0]);
-
-        skin->placeMeterBar("meter_kmeter_right",
-                            levelMeters_[1]);
-        skin->placeAndSkinStateLabel("label_over_right",
-                                     overflowMeters_[1]);
-        skin->placeAndSkinStateLabel("label_peak_right",
-                                     maximumPeakLabels_[1]);
-        skin->placeAndSkinStateLabel("label_true_peak_right",
-                                     maximumTruePeakLabels_[1]);
+        for (int channel = 0; channel < numberOfInputChannels_; ++channel)
+        {
+            maximumPeakLabels_[channel]->setCrestFactor(crestFactor);
+            maximumTruePeakLabels_[channel]->setCrestFactor(crestFactor);
+        }
     }
-    else if (numberOfInputChannels_ == 6)
+
+    // components are looked up by channel type, so skins may
+    // support any channel layout
+    bool isSupportedBySkin = true;
+
+    for (int channel = 0; channel < numberOfInputChannels_; ++channel)
     {
-        skin->placeMeterBar("meter_kmeter_left",
-                            levelMeters_[0]);
-        skin->placeAndSkinStateLabel("label_over_left",
-                                     overflowMeters_[0]);
-        skin->placeAndSkinStateLabel("label_peak_left",
-                                     maximumPeakLabels_[0]);
-        skin->placeAndSkinStateLabel("label_true_peak_left",
-                                     maximumTruePeakLabels_[0]);
-
-        skin->placeMeterBar("meter_kmeter_right",
-                            levelMeters_[1]);
-        skin->placeAndSkinStateLabel("label_over_right",
-                                     overflowMeters_[1]);
-        skin->placeAndSkinStateLabel("label_peak_right",
-                                     maximumPeakLabels_[1]);
-        skin->placeAndSkinStateLabel("label_true_peak_right",
-                                     maximumTruePeakLabels_[1]);
-
-        skin->placeMeterBar("meter_kmeter_center",
-                            levelMeters_[2]);
-        skin->placeAndSkinStateLabel("label_over_center",
-                                     overflowMeters_[2]);
-        skin->placeAndSkinStateLabel("label_peak_center",
-                                     maximumPeakLabels_[2]);
-        skin->placeAndSkinStateLabel("label_true_peak_center",
-                                     maximumTruePeakLabels_[2]);
-
-        skin->placeMeterBar("meter_kmeter_lfe",
-                            levelMeters_[3]);
-        skin->placeAndSkinStateLabel("label_over_lfe",
-                                     overflowMeters_[3]);
-        skin->placeAndSkinStateLabel("label_peak_lfe",
-                                     maximumPeakLabels_[3]);
-        skin->placeAndSkinStateLabel("label_true_peak_lfe",
-                                     maximumTruePeakLabels_[3]);
-
-        skin->placeMeterBar("meter_kmeter_ls",
-                            levelMeters_[4]);
-        skin->placeAndSkinStateLabel("label_over_ls",
-                                     overflowMeters_[4]);
-        skin->placeAndSkinStateLabel("label_peak_ls",
-                                     maximumPeakLabels_[4]);
-        skin->placeAndSkinStateLabel("label_true_peak_ls",
-                                     maximumTruePeakLabels_[4]);
-
-        skin->placeMeterBar("meter_kmeter_rs",
-                            levelMeters_[5]);
-        skin->placeAndSkinStateLabel("label_over_rs",
-                                     overflowMeters_[5]);
-        skin->placeAndSkinStateLabel("label_peak_rs",
-                                     maximumPeakLabels_[5]);
-        skin->placeAndSkinStateLabel("label_true_peak_rs",
-                                     maximumTruePeakLabels_[5]);
+        String suffix = getChannelSuffix(channel);
+
+        if (skin->getComponent("meter_kmeter" + suffix) == nullptr)
+        {
+            DBG("[K-Meter] skin does not support channel \"" +
+                channelSet_.getChannelTypeName(
+                    channelSet_.getTypeOfChannel(channel)) +
+                "\" (" + channelSet_.getDescription() + ")");
+
+            isSupportedBySkin = false;
+        }
+    }
+
+    if (isSupportedBySkin)
+    {
+        for (int channel = 0; channel < numberOfInputChannels_; ++channel)
+        {
+            String suffix = getChannelSuffix(channel);
+
+            skin->placeMeterBar("meter_kmeter" + suffix,
+                                levelMeters_[channel]);
+            skin->placeAndSkinStateLabel("label_over" + suffix,
+                                         overflowMeters_[channel]);
+            skin->placeAndSkinStateLabel("label_peak" + suffix,
+                                         maximumPeakLabels_[channel]);
+            skin->placeAndSkinStateLabel("label_true_peak" + suffix,
+                                         maximumTruePeakLabels_[channel]);
+
+            // labels may have been hidden by a previous skin
+            overflowMeters_[channel]->setVisible(true);
+            maximumPeakLabels_[channel]->setVisible(true);
+            maximumTruePeakLabels_[channel]->setVisible(true);
+        }
     }
     else
     {
-        DBG("[K-Meter] channel configuration (" +
-            String(numberOfInputChannels_) +
-            " channels) not supported");
+        placeChannelsAutomatically(skin);
     }
 
     Component *parent = getParentComponent();
@@ -229,6 +271,13 @@ void Kmeter::applySkin(
     {
         setBounds(0, 0, parent->getWidth(), parent->getHeight());
     }
+    // meter bars of other layouts still show old readings
+    updateMeterBars();
+
+    if (meterBallistics_ != nullptr)
+    {
+        updateLabels(meterBallistics_);
+    }
 }
 
 
@@ -237,27 +286,300 @@ void Kmeter::resized()
 }
 
 
+// Places all channels of a layout that the skin does not support
+// (such as 7.1.4 or Ambisonics).  Meter bars and labels are spread
+// evenly over the area that the skin reserves for its own meters and
+// are skinned like the first meter of the skin.  Labels that do not
+// fit into a channel's column are hidden.
+void Kmeter::placeChannelsAutomatically(
+    Skin *skin)
+
+{
+    // channels that skins usually provide components for
+    const StringArray knownSuffixes({"", "_left", "_right", "_center",
+                                     "_lfe", "_ls", "_rs"
+                                    });
+
+    String templateSuffix;
+    XmlElement *xmlTemplate = nullptr;
+
+    for (const auto &suffix : knownSuffixes)
+    {
+        xmlTemplate = skin->getComponent("meter_kmeter" + suffix);
+
+        if (xmlTemplate != nullptr)
+        {
+            templateSuffix = suffix;
+            break;
+        }
+    }
+
+    if (xmlTemplate == nullptr)
+    {
+        DBG("[K-Meter] skin does not contain any meter");
+        return;
+    }
+
+    bool isVertical = skin->getBoolean(xmlTemplate, "vertical", true);
+    int templateSegmentWidth = skin->getInteger(xmlTemplate,
+                                                "segment_width", 8);
+
+    // skin first channel like template to find out component sizes
+    skin->placeMeterBar("meter_kmeter" + templateSuffix,
+                        levelMeters_[0]);
+    skin->placeAndSkinStateLabel("label_over" + templateSuffix,
+                                 overflowMeters_[0]);
+    skin->placeAndSkinStateLabel("label_peak" + templateSuffix,
+                                 maximumPeakLabels_[0]);
+    skin->placeAndSkinStateLabel("label_true_peak" + templateSuffix,
+                                 maximumTruePeakLabels_[0]);
+
+    Array<Component *> templateComponents;
+    templateComponents.add(levelMeters_[0]);
+    templateComponents.add(overflowMeters_[0]);
+    templateComponents.add(maximumPeakLabels_[0]);
+    templateComponents.add(maximumTruePeakLabels_[0]);
+
+    const StringArray tagPrefixes({"meter_kmeter", "label_over",
+                                   "label_peak", "label_true_peak"
+                                  });
+
+    // area covered by the skin's meters and labels
+    Rectangle<int> meterArea;
+
+    for (const auto &suffix : knownSuffixes)
+    {
+        for (int index = 0; index < tagPrefixes.size(); ++index)
+        {
+            XmlElement *xmlComponent = skin->getComponent(
+                                           tagPrefixes[index] + suffix);
+
+            if (xmlComponent != nullptr)
+            {
+                Component *component = templateComponents[index];
+
+                meterArea = meterArea.getUnion(
+                                skin->getBounds(xmlComponent,
+                                                component->getWidth(),
+                                                component->getHeight()));
+            }
+        }
+    }
+
+    // meter bars are placed side by side, so divide the area across
+    // the meter bars
+    int areaStart = isVertical ? meterArea.getX() : meterArea.getY();
+    int areaLength = isVertical ? meterArea.getWidth() : meterArea.getHeight();
+
+    float columnPitch = static_cast<float>(areaLength) /
+                        static_cast<float>(numberOfInputChannels_);
+    int columnSize = static_cast<int>(columnPitch);
+
+    // leave a small gap between meter bars
+    int segmentWidth = jlimit(4, jmax(4, templateSegmentWidth),
+                              columnSize - 4);
+
+    for (int channel = 0; channel < numberOfInputChannels_; ++channel)
+    {
+        int columnStart = areaStart + roundToInt(channel * columnPitch);
+
+        Array<Component *> components;
+        components.add(levelMeters_[channel]);
+        components.add(overflowMeters_[channel]);
+        components.add(maximumPeakLabels_[channel]);
+        components.add(maximumTruePeakLabels_[channel]);
+
+        skin->placeMeterBar("meter_kmeter" + templateSuffix,
+                            levelMeters_[channel]);
+        levelMeters_[channel]->setSegmentWidth(segmentWidth);
+
+        skin->placeAndSkinStateLabel("label_over" + templateSuffix,
+                                     overflowMeters_[channel]);
+        skin->placeAndSkinStateLabel("label_peak" + templateSuffix,
+                                     maximumPeakLabels_[channel]);
+        skin->placeAndSkinStateLabel("label_true_peak" + templateSuffix,
+                                     maximumTruePeakLabels_[channel]);
+
+        // centre all components in their column
+        for (int index = 0; index < components.size(); ++index)
+        {
+            Component *component = components[index];
+
+            int componentSize = isVertical ? component->getWidth() :
+                                component->getHeight();
+            int offset = columnStart + (columnSize - componentSize) / 2;
+
+            if (isVertical)
+            {
+                component->setTopLeftPosition(offset, component->getY());
+            }
+            else
+            {
+                component->setTopLeftPosition(component->getX(), offset);
+            }
+
+            // meter bars always fit
+            if (index > 0)
+            {
+                component->setVisible(componentSize <= columnSize);
+            }
+        }
+    }
+}
+
+
+// Returns the suffix of a channel's skin components ("_left" for
+// "meter_kmeter_left" and so on).  Mono meters have no suffix.
+String Kmeter::getChannelSuffix(
+    int channel)
+
+{
+    if (numberOfInputChannels_ == 1)
+    {
+        return String();
+    }
+
+    AudioChannelSet::ChannelType channelType =
+        channelSet_.getTypeOfChannel(channel);
+
+    switch (channelType)
+    {
+    case AudioChannelSet::left:
+        return "_left";
+
+    case AudioChannelSet::right:
+        return "_right";
+
+    case AudioChannelSet::centre:
+        return "_center";
+
+    case AudioChannelSet::LFE:
+        return "_lfe";
+
+    case AudioChannelSet::leftSurround:
+        return "_ls";
+
+    case AudioChannelSet::rightSurround:
+        return "_rs";
+
+    default:
+        break;
+    }
+
+    // all other channels use their abbreviated name ("_lrs",
+    // "_tfl", ...); discrete channels are simply numbered
+    String channelName = AudioChannelSet::getAbbreviatedChannelTypeName(
+                             channelType).toLowerCase();
+
+    if (channelName.isEmpty() || !channelName.containsOnly(
+                "abcdefghijklmnopqrstuvwxyz0123456789"))
+    {
+        channelName = String(channel + 1);
+    }
+
+    return "_" + channelName;
+}
+
+
+// Stores new meter readings.  Meter bars are animated towards these
+// readings by animate(), which should be called on every frame.
 void Kmeter::setLevels(
     std::shared_ptr<MeterBallistics> meterBallistics)
 
 {
+    meterBallistics_ = meterBallistics;
+
+    if (levelAnimation_.getNumberOfValues() !=
+            numberOfInputChannels_ * numberOfAnimatedReadings)
+    {
+        return;
+    }
+
+    levelAnimation_.beginSnapshot();
+
     for (int channel = 0; channel < numberOfInputChannels_; ++channel)
     {
+        int offset = channel * numberOfAnimatedReadings;
+
+        // peaks rise immediately; peak marks fall linearly, so
+        // interpolation yields their decay at display rate
+        levelAnimation_.setTarget(
+            offset + averageLevel,
+            meterBallistics->getAverageMeterLevel(channel),
+            false);
+
+        levelAnimation_.setTarget(
+            offset + averageLevelPeak,
+            meterBallistics->getAverageMeterPeakLevel(channel),
+            true);
+
+        levelAnimation_.setTarget(
+            offset + peakLevel,
+            meterBallistics->getPeakMeterLevel(channel),
+            true);
+
+        levelAnimation_.setTarget(
+            offset + peakLevelPeak,
+            meterBallistics->getPeakMeterPeakLevel(channel),
+            true);
+    }
+
+    updateLabels(meterBallistics);
+}
+
+
+// Moves meter bars towards the latest meter readings.
+void Kmeter::animate()
+{
+    levelAnimation_.advance();
+    updateMeterBars();
+}
+
+
+// Moves meter bars to the latest meter readings.
+void Kmeter::skipAnimation()
+{
+    levelAnimation_.skip();
+    updateMeterBars();
+}
+
+
+void Kmeter::updateMeterBars()
+{
+    if (levelAnimation_.getNumberOfValues() !=
+            levelMeters_.size() * numberOfAnimatedReadings)
+    {
+        return;
+    }
+
+    for (int channel = 0; channel < levelMeters_.size(); ++channel)
+    {
+        int offset = channel * numberOfAnimatedReadings;
+
         if (displayPeakMeter_)
         {
             levelMeters_[channel]->setLevels(
-                meterBallistics->getAverageMeterLevel(channel),
-                meterBallistics->getAverageMeterPeakLevel(channel),
-                meterBallistics->getPeakMeterLevel(channel),
-                meterBallistics->getPeakMeterPeakLevel(channel));
+                levelAnimation_.getValue(offset + averageLevel),
+                levelAnimation_.getValue(offset + averageLevelPeak),
+                levelAnimation_.getValue(offset + peakLevel),
+                levelAnimation_.getValue(offset + peakLevelPeak));
         }
         else
         {
             levelMeters_[channel]->setNormalLevels(
-                meterBallistics->getAverageMeterLevel(channel),
-                meterBallistics->getAverageMeterPeakLevel(channel));
+                levelAnimation_.getValue(offset + averageLevel),
+                levelAnimation_.getValue(offset + averageLevelPeak));
         }
+    }
+}
+
 
+void Kmeter::updateLabels(
+    std::shared_ptr<MeterBallistics> meterBallistics)
+
+{
+    for (int channel = 0; channel < overflowMeters_.size(); ++channel)
+    {
         maximumPeakLabels_[channel]->updateLevel(
             meterBallistics->getMaximumPeakLevel(channel));
 
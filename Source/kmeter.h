@@ -41,7 +41,7 @@ public:
     static const int KMETER_STEREO_WIDTH = 106;
     static const int KMETER_STEREO_WIDTH_2 = KMETER_STEREO_WIDTH / 2;
 
-    virtual void create(int numberOfInputChannels);
+    virtual void create(const AudioChannelSet &channelSet);
 
     virtual void applySkin(Skin *skin,
                            int crestFactor,
@@ -52,17 +52,56 @@ public:
 
     virtual void setLevels(std::shared_ptr<MeterBallistics> meterBallistics);
 
+    virtual void animate();
+    virtual void skipAnimation();
+
     virtual void resized();
 
 protected:
-    OwnedArray<MeterBar> levelMeters_;
+    String getChannelSuffix(int channel);
+    void placeChannelsAutomatically(Skin *skin);
+
+    // meter readings of each channel that are animated at display
+    // rate
+    enum animatedReading  // protected namespace
+    {
+        averageLevel = 0,
+        averageLevelPeak,
+        peakLevel,
+        peakLevelPeak,
+        numberOfAnimatedReadings
+    };
+
+    void updateMeterBars();
+    void updateLabels(std::shared_ptr<MeterBallistics> meterBallistics);
+
+    static int getLayoutKey(int crestFactor,
+                            bool discreteMeter,
+                            bool isExpanded,
+                            bool isHorizontal);
+
+    // meter bars of the current scale layout
+    Array<MeterBar *> levelMeters_;
+
+    // meter bars of all scale layouts that have been built so far;
+    // maps layout key to index of layout's first meter bar
+    OwnedArray<MeterBar> meterBarCache_;
+    HashMap<int, int> meterBarLayouts_;
+
     OwnedArray<OverflowMeter> overflowMeters_;
     OwnedArray<PeakLabel> maximumPeakLabels_;
     OwnedArray<PeakLabel> maximumTruePeakLabels_;
 
+    std::shared_ptr<MeterBallistics> meterBallistics_;
+    frut::widgets::SnapshotInterpolator levelAnimation_;
+
+    AudioChannelSet channelSet_;
     int numberOfInputChannels_;
     bool displayPeakMeter_;
 
+    int segmentHeight_;
+    Array<Colour> segmentColours_;
+
 private:
     JUCE_LEAK_DETECTOR(Kmeter);
 };
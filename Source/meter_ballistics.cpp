@@ -62,9 +62,52 @@ MeterBallistics::MeterBallistics(
     // store the number of audio input channels
     nNumberOfChannels = nChannels;
 
+    // pad channel arrays to a multiple of 16 values (64 bytes, the
+    // size of a cache line)
+    nChannelStride = ((nNumberOfChannels + 15) / 16) * 16;
+
+    // allocate one extra cache line for alignment
+    const int nNumberOfArrays = 13;
+    arrStateMemory.calloc(nNumberOfArrays * nChannelStride + 16);
+
+    float *pState = snapPointerToAlignment(arrStateMemory.get(), 64);
+
+    arrPeakMeterLevels = pState + 0 * nChannelStride;
+    arrPeakMeterPeakLevels = pState + 1 * nChannelStride;
+
+    arrTruePeakMeterLevels = pState + 2 * nChannelStride;
+    arrTruePeakMeterPeakLevels = pState + 3 * nChannelStride;
+
+    arrAverageMeterLevels = pState + 4 * nChannelStride;
+    arrAverageMeterPeakLevels = pState + 5 * nChannelStride;
+
+    arrMaximumPeakLevels = pState + 6 * nChannelStride;
+    arrMaximumTruePeakLevels = pState + 7 * nChannelStride;
+
+    arrPeakMeterPeakLastChanged = pState + 8 * nChannelStride;
+    arrTruePeakMeterPeakLastChanged = pState + 9 * nChannelStride;
+    arrAverageMeterPeakLastChanged = pState + 10 * nChannelStride;
+
+    // temporary storage for levels in decibels
+    arrPeakDecibels = pState + 11 * nChannelStride;
+    arrTruePeakDecibels = pState + 12 * nChannelStride;
+
+    arrNumberOfOverflows.calloc(nNumberOfChannels);
+
+    // force calculation of ballistics coefficients on first update
+    fCoefficientsTimePassed = -1.0f;
+    fPeakReleaseCoef = 0.0f;
+    fAverageAttackReleaseCoef = 0.0f;
+
+    fStereoCoefficientTimePassed = -1.0f;
+    fStereoAttackReleaseCoef = 0.0f;
+
     // store algorithm for average meter levels
     setAverageAlgorithm(AverageAlgorithm);
 
+    // use fast decibel conversions
+    setExactConversion(false);
+
     // select "infinite peak hold" or "falling peaks" mode
     setPeakMeterInfiniteHold(bPeakMeterInfiniteHold);
     setAverageMeterInfiniteHold(bAverageMeterInfiniteHold);
@@ -79,6 +122,28 @@ void MeterBallistics::reset()
 
     return value: none
 */
+{
+    resetMeterLevels();
+
+    // loop through all audio channels
+    for (int nChannel = 0; nChannel < nNumberOfChannels; ++nChannel)
+    {
+        // set overall maximum peak levels to meter's minimum
+        arrMaximumPeakLevels[nChannel] = fMeterMinimumDecibel;
+        arrMaximumTruePeakLevels[nChannel] = fMeterMinimumDecibel;
+
+        // reset number of registered overflows
+        arrNumberOfOverflows[nChannel] = 0;
+    }
+}
+
+
+void MeterBallistics::resetMeterLevels()
+/*  Reset meter levels and peak marks, but keep overall maximum peak
+    levels and number of overflows
+
+    return value: none
+*/
 {
     // default phase correlation is "+1.0" (mono-compatible)
     fPhaseCorrelation = 1.0f;
@@ -90,24 +155,17 @@ void MeterBallistics::reset()
     for (int nChannel = 0; nChannel < nNumberOfChannels; ++nChannel)
     {
         // set peak meter's level and peak mark to meter's minimum
-        arrPeakMeterLevels.set(nChannel, fMeterMinimumDecibel);
-        arrPeakMeterPeakLevels.set(nChannel, fMeterMinimumDecibel);
+        arrPeakMeterLevels[nChannel] = fMeterMinimumDecibel;
+        arrPeakMeterPeakLevels[nChannel] = fMeterMinimumDecibel;
 
         // set true peak meter's level and peak mark to meter's
         // minimum
-        arrTruePeakMeterLevels.set(nChannel, fMeterMinimumDecibel);
-        arrTruePeakMeterPeakLevels.set(nChannel, fMeterMinimumDecibel);
+        arrTruePeakMeterLevels[nChannel] = fMeterMinimumDecibel;
+        arrTruePeakMeterPeakLevels[nChannel] = fMeterMinimumDecibel;
 
         // set average meter's level and peak mark to meter's minimum
-        arrAverageMeterLevels.set(nChannel, fMeterMinimumDecibel);
-        arrAverageMeterPeakLevels.set(nChannel, fMeterMinimumDecibel);
-
-        // set overall maximum peak levels to meter's minimum
-        arrMaximumPeakLevels.set(nChannel, fMeterMinimumDecibel);
-        arrMaximumTruePeakLevels.set(nChannel, fMeterMinimumDecibel);
-
-        // reset number of registered overflows
-        arrNumberOfOverflows.set(nChannel, 0);
+        arrAverageMeterLevels[nChannel] = fMeterMinimumDecibel;
+        arrAverageMeterPeakLevels[nChannel] = fMeterMinimumDecibel;
     }
 }
 
@@ -144,15 +202,15 @@ void MeterBallistics::setPeakMeterInfiniteHold(
         // so this effectively selects "infinite peak hold" mode
         if (bInfiniteHold)
         {
-            arrPeakMeterPeakLastChanged.set(nChannel, -1.0f);
-            arrTruePeakMeterPeakLastChanged.set(nChannel, -1.0f);
+            arrPeakMeterPeakLastChanged[nChannel] = -1.0f;
+            arrTruePeakMeterPeakLastChanged[nChannel] = -1.0f;
         }
         // select "falling peaks" mode by resetting time since peak
         // mark was last changed
         else
         {
-            arrPeakMeterPeakLastChanged.set(nChannel, 0.0f);
-            arrTruePeakMeterPeakLastChanged.set(nChannel, 0.0f);
+            arrPeakMeterPeakLastChanged[nChannel] = 0.0f;
+            arrTruePeakMeterPeakLastChanged[nChannel] = 0.0f;
         }
     }
 }
@@ -175,18 +233,32 @@ void MeterBallistics::setAverageMeterInfiniteHold(
         // so this effectively selects "infinite peak hold" mode
         if (bInfiniteHold)
         {
-            arrAverageMeterPeakLastChanged.set(nChannel, -1.0f);
+            arrAverageMeterPeakLastChanged[nChannel] = -1.0f;
         }
         // select "falling peaks" mode by resetting time since peak mark
         // was last changed
         else
         {
-            arrAverageMeterPeakLastChanged.set(nChannel, 0.0f);
+            arrAverageMeterPeakLastChanged[nChannel] = 0.0f;
         }
     }
 }
 
 
+void MeterBallistics::setExactConversion(
+    bool bExact)
+/*  Select exact or fast conversion of levels to decibels.
+
+    bExact (Boolean): selects exact conversion (true) or fast
+    conversion (false); use exact conversion for validation
+
+    return value: none
+*/
+{
+    bExactConversion = bExact;
+}
+
+
 int MeterBallistics::getNumberOfChannels()
 /*  Get number of audio channels.
 
@@ -695,44 +767,70 @@ void MeterBallistics::updateChannel(
     jassert(nChannel >= 0);
     jassert(nChannel < nNumberOfChannels);
 
-    // convert current peak meter level from linear scale to decibels
-    fPeak = level2decibel(fPeak);
+    ApplyBallistics(nChannel, 1, fTimePassed,
+                    &fPeak, &fTruePeak, &fAverageFiltered, &nOverflows);
+}
 
-    // convert current true peak meter level from linear scale to
-    // decibels
-    fTruePeak = level2decibel(fTruePeak);
 
-    // if current peak meter level exceeds overall maximum peak level,
-    // store it as new overall maximum peak level
-    if (fPeak > arrMaximumPeakLevels[nChannel])
-    {
-        arrMaximumPeakLevels.set(nChannel, fPeak);
-    }
+void MeterBallistics::updateChannels(
+    float fTimePassed,
+    const float *arrPeak,
+    const float *arrTruePeak,
+    const float *arrAverageFiltered,
+    const int *arrOverflows)
+/*  Update audio levels, overflows and apply meter ballistics for all
+    audio channels at once.
 
-    // if current true peak meter level exceeds overall maximum true
-    // peak level, store it as new overall maximum true peak level
-    if (fTruePeak > arrMaximumTruePeakLevels[nChannel])
-    {
-        arrMaximumTruePeakLevels.set(nChannel, fTruePeak);
-    }
+    fTimePassed (float): time that has passed since last update (in
+    fractional seconds)
 
-    // apply peak meter's ballistics and store resulting level and
-    // peak mark
-    arrPeakMeterLevels.set(nChannel, PeakMeterBallistics(fTimePassed, fPeak, arrPeakMeterLevels[nChannel]));
-    arrPeakMeterPeakLevels.set(nChannel, PeakMeterPeakBallistics(fTimePassed, arrPeakMeterPeakLastChanged.getReference(nChannel), fPeak, arrPeakMeterPeakLevels[nChannel]));
+    arrPeak (float array): current peak meter levels (linear scale)
 
-    // apply true peak meter's ballistics and store resulting level
-    // and peak mark
-    arrTruePeakMeterLevels.set(nChannel, PeakMeterBallistics(fTimePassed, fTruePeak, arrTruePeakMeterLevels[nChannel]));
-    arrTruePeakMeterPeakLevels.set(nChannel, PeakMeterPeakBallistics(fTimePassed, arrTruePeakMeterPeakLastChanged.getReference(nChannel), fTruePeak, arrTruePeakMeterPeakLevels[nChannel]));
+    arrTruePeak (float array): current true peak meter levels (linear
+    scale)
 
-    // apply average meter's ballistics and store resulting level and
-    // peak mark
-    AverageMeterBallistics(nChannel, fTimePassed, fAverageFiltered);
-    arrAverageMeterPeakLevels.set(nChannel, AverageMeterPeakBallistics(fTimePassed, arrAverageMeterPeakLastChanged.getReference(nChannel), arrAverageMeterLevels[nChannel], arrAverageMeterPeakLevels[nChannel]));
+    arrAverageFiltered (float array): current pre-filtered average
+    meter levels (in decibels!)
 
-    // update registered number of overflows
-    arrNumberOfOverflows.set(nChannel, arrNumberOfOverflows[nChannel] + nOverflows);
+    arrOverflows (integer array): number of overflows in buffer chunk
+
+    return value: none
+*/
+{
+    FRUT_PROFILE_SCOPE("MeterBallistics::updateChannels");
+
+    ApplyBallistics(0, nNumberOfChannels, fTimePassed,
+                    arrPeak, arrTruePeak, arrAverageFiltered, arrOverflows);
+}
+
+
+void MeterBallistics::updateMaxima(
+    const float *arrPeak,
+    const float *arrTruePeak,
+    const int *arrOverflows)
+/*  Update overall maximum levels and overflows of all audio channels
+    without applying any meter ballistics.  Use this when no one is
+    looking at the meters.
+
+    arrPeak (float array): current peak meter levels (linear scale)
+
+    arrTruePeak (float array): current true peak meter levels (linear
+    scale)
+
+    arrOverflows (integer array): number of overflows in buffer chunk
+
+    return value: none
+*/
+{
+    ConvertToDecibels(0, nNumberOfChannels, arrPeak, arrTruePeak);
+
+    for (int n = 0; n < nNumberOfChannels; ++n)
+    {
+        arrMaximumPeakLevels[n] = jmax(arrMaximumPeakLevels[n], arrPeakDecibels[n]);
+        arrMaximumTruePeakLevels[n] = jmax(arrMaximumTruePeakLevels[n], arrTruePeakDecibels[n]);
+
+        arrNumberOfOverflows[n] += arrOverflows[n];
+    }
 }
 
 
@@ -842,169 +940,270 @@ double MeterBallistics::decibel2level_double(
 }
 
 
+float MeterBallistics::level2decibel_fast(
+    float fLevel)
+/*  Convert level from linear scale to decibels (dB) using a fast
+    approximation of log2().  This code has no library calls and no
+    branches, so it can be vectorised.
+
+    The error is below 0.001 dB between "fMeterMinimumDecibel" and
+    +20 dB (see "MeterBallisticsTest").
+
+    fLevel (float): audio level
+
+    return value (float): returns given level in decibels (dB) when
+    above "fMeterMinimumDecibel", otherwise "fMeterMinimumDecibel"
+*/
+{
+    // log(0) is not defined; this also avoids denormals (the
+    // resulting level is clamped anyway)
+    fLevel = jmax(fLevel, 1e-20f);
+
+    // split level into exponent and mantissa (1.0 <= m < 2.0)
+    uint32 nBits;
+    memcpy(&nBits, &fLevel, sizeof(nBits));
+
+    int nExponent = static_cast<int>((nBits >> 23) & 0xff) - 127;
+    nBits = (nBits & 0x007fffff) | 0x3f800000;
+
+    float fMantissa;
+    memcpy(&fMantissa, &nBits, sizeof(fMantissa));
+
+    // move mantissa to [sqrt(0.5), sqrt(2)) to speed up convergence
+    bool bHalveMantissa = (fMantissa > 1.41421356f);
+
+    fMantissa = bHalveMantissa ? 0.5f * fMantissa : fMantissa;
+    nExponent += bHalveMantissa ? 1 : 0;
+
+    // log2(m) = 2 / ln(2) * atanh((m - 1) / (m + 1)); the series is
+    // cut off after the fifth power
+    float t = (fMantissa - 1.0f) / (fMantissa + 1.0f);
+    float t2 = t * t;
+    float fLog2 = static_cast<float>(nExponent) +
+                  t * (2.88539008f + t2 * (0.96179669f + t2 * 0.57707802f));
+
+    // 20 * log10(x) = 20 * log10(2) * log2(x)
+    float fDecibels = 6.02059991f * fLog2;
+
+    // to make meter ballistics look nice for low levels, do not
+    // return levels below "fMeterMinimumDecibel"
+    return jmax(fDecibels, fMeterMinimumDecibel);
+}
+
+
 float MeterBallistics::getMeterMinimumDecibel()
 {
     return fMeterMinimumDecibel;
 }
 
 
-float MeterBallistics::PeakMeterBallistics(
-    float fTimePassed,
-    float fPeakLevelCurrent,
-    float fPeakLevelOld)
-/*  Calculate ballistics for peak meter levels.
+void MeterBallistics::UpdateCoefficients(
+    float fTimePassed)
+/*  Calculate ballistics coefficients.
 
     fTimePassed (float): time that has passed since last update (in
     fractional seconds)
 
-    fPeakLevelCurrent (float): current peak meter level in decibel
+    return value: none
+*/
+{
+    fCoefficientsTimePassed = fTimePassed;
 
-    fPeakLevelOld (float): old peak meter reading in decibel
+    // fall time: 26 dB in 3 seconds (linear)
+    fPeakReleaseCoef = 26.0f * fTimePassed / 3.0f;
 
-    return value (float): new peak meter reading in decibel
+    // Thanks to Bram de Jong for the code snippet!
+    // (http://www.musicdsp.org/showone.php?id=136)
+    //
+    // average meter: 99% of final reading in 0.6 s (logarithmic)
+    fAverageAttackReleaseCoef = powf(0.01f, fTimePassed / 0.600f);
+}
+
+
+void MeterBallistics::UpdateStereoCoefficient(
+    float fTimePassed)
+/*  Calculate ballistics coefficient of stereo and phase correlation
+    meters.  These meters may be updated less often than the level
+    meters, so the coefficient is cached separately.
+
+    fTimePassed (float): time that has passed since last update (in
+    fractional seconds)
+
+    return value: none
 */
 {
-    // apply rise time if peak level is above old level
-    if (fPeakLevelCurrent >= fPeakLevelOld)
-    {
-        // immediate rise time, so return current peak level as new
-        // peak meter reading
-        return fPeakLevelCurrent;
-    }
-    // otherwise, apply fall time
-    else
-    {
-        // fall time: 26 dB in 3 seconds (linear)
-        float fReleaseCoef = 26.0f * fTimePassed / 3.0f;
+    fStereoCoefficientTimePassed = fTimePassed;
+
+    // stereo and phase correlation meters: 99% of final reading in
+    // 1.2 s (logarithmic)
+    fStereoAttackReleaseCoef = powf(0.01f, fTimePassed / 1.200f);
+}
+
+
+void MeterBallistics::ConvertToDecibels(
+    int nFirstChannel,
+    int nChannels,
+    const float *arrPeak,
+    const float *arrTruePeak)
+/*  Convert current (true) peak meter levels from linear scale to
+    decibels and store them in "arrPeakDecibels" and
+    "arrTruePeakDecibels".
+
+    nFirstChannel (integer): first audio input channel to convert
+
+    nChannels (integer): number of audio input channels to convert
+
+    arrPeak (float array): current peak meter levels (linear scale)
+
+    arrTruePeak (float array): current true peak meter levels (linear
+    scale)
 
-        // apply fall time and return new peak meter reading
-        fPeakLevelOld -= fReleaseCoef;
+    return value: none
+*/
+{
+    float *arrPeakDb = arrPeakDecibels + nFirstChannel;
+    float *arrTruePeakDb = arrTruePeakDecibels + nFirstChannel;
 
-        // make sure that meter doesn't fall below current level
-        if (fPeakLevelCurrent > fPeakLevelOld)
+    if (bExactConversion)
+    {
+        for (int n = 0; n < nChannels; ++n)
         {
-            return fPeakLevelCurrent;
+            arrPeakDb[n] = level2decibel(arrPeak[n]);
+            arrTruePeakDb[n] = level2decibel(arrTruePeak[n]);
         }
-        else
+    }
+    else
+    {
+        for (int n = 0; n < nChannels; ++n)
         {
-            return fPeakLevelOld;
+            arrPeakDb[n] = level2decibel_fast(arrPeak[n]);
+            arrTruePeakDb[n] = level2decibel_fast(arrTruePeak[n]);
         }
     }
 }
 
 
-float MeterBallistics::PeakMeterPeakBallistics(
+void MeterBallistics::ApplyBallistics(
+    int nFirstChannel,
+    int nChannels,
     float fTimePassed,
-    float &fLastChanged,
-    float fPeakCurrent,
-    float fPeakOld)
-/*  Calculate ballistics for peak meter peak marks.
+    const float *arrPeak,
+    const float *arrTruePeak,
+    const float *arrAverageFiltered,
+    const int *arrOverflows)
+/*  Update audio levels, overflows and apply meter ballistics for a
+    range of audio channels.  The channels are processed in parallel
+    (one array per reading), which allows the compiler to vectorise
+    the main loop.
+
+    nFirstChannel (integer): first audio input channel to update
+
+    nChannels (integer): number of audio input channels to update
 
     fTimePassed (float): time that has passed since last update (in
     fractional seconds)
 
-    fLastChanged (reference to float): time since peak mark was last
-    changed in fractional seconds
+    arrPeak (float array): current peak meter levels (linear scale)
 
-    fPeakCurrent (float): current peak level mark in decibel
+    arrTruePeak (float array): current true peak meter levels (linear
+    scale)
 
-    fPeakOld (float): old peak level mark in decibel
+    arrAverageFiltered (float array): current pre-filtered average
+    meter levels (in decibels!)
 
-    return value (float): new peak level mark in decibel
+    arrOverflows (integer array): number of overflows in buffer chunk
+
+    return value: none
 */
 {
-    float fOutput;
+    jassert(nFirstChannel >= 0);
+    jassert(nFirstChannel + nChannels <= nNumberOfChannels);
 
-    // prevent meter overshoot on overflows by limiting peak levels to
-    // 0.0 dBFS
-    if (fPeakCurrent >= 0.0f)
+    if (fTimePassed != fCoefficientsTimePassed)
     {
-        fPeakCurrent = 0.0f;
+        UpdateCoefficients(fTimePassed);
     }
 
-    // apply rise time if peak level is above old level
-    if (fPeakCurrent >= fPeakOld)
-    {
-        // if peak meter is set to "falling peaks" mode (non-negative
-        // values), reset hold time (time that peaks are held before
-        // starting to fall back down)
-        if (fLastChanged >= 0.0f)
-        {
-            fLastChanged = 0.0f;
-        }
+    // convert current (true) peak meter levels from linear scale to
+    // decibels; this keeps function calls out of the main loop
+    ConvertToDecibels(nFirstChannel, nChannels, arrPeak, arrTruePeak);
 
-        // immediate rise time, so set current peak level mark as new
-        // peak level mark
-        fOutput = fPeakCurrent;
-    }
-    // otherwise, test whether to apply fall time
-    else
-    {
-        // if peak meter is set to "falling peaks" mode (non-negative
-        // values), update hold time (time that peaks are held before
-        // starting to fall back down)
-        if (fLastChanged >= 0.0f)
-        {
-            fLastChanged += fTimePassed;
-        }
+    float *arrPeakDb = arrPeakDecibels + nFirstChannel;
+    float *arrTruePeakDb = arrTruePeakDecibels + nFirstChannel;
 
-        // peak meter is EITHER set to "infinite peak hold" mode
-        // (negative values) OR the peak meter's hold time of 10
-        // seconds has not yet been exceeded, so retain old peak level
-        // mark
-        if (fLastChanged < 10.0f)
-        {
-            fOutput = fPeakOld;
-        }
-        // peak meter's hold time (10 seconds) has been reached or
-        // exceeded
-        else
-        {
-            // fall time: 26 dB in 3 seconds (linear)
-            float fReleaseCoef = 26.0f * fTimePassed / 3.0f;
+    float *arrPeakLevels = arrPeakMeterLevels + nFirstChannel;
+    float *arrPeakPeakLevels = arrPeakMeterPeakLevels + nFirstChannel;
+    float *arrPeakLastChanged = arrPeakMeterPeakLastChanged + nFirstChannel;
 
-            // apply fall time
-            fOutput = fPeakOld - fReleaseCoef;
+    float *arrTruePeakLevels = arrTruePeakMeterLevels + nFirstChannel;
+    float *arrTruePeakPeakLevels = arrTruePeakMeterPeakLevels + nFirstChannel;
+    float *arrTruePeakLastChanged = arrTruePeakMeterPeakLastChanged + nFirstChannel;
 
-            // make sure that meter doesn't fall below current level
-            if (fPeakCurrent > fOutput)
-            {
-                fOutput = fPeakCurrent;
-            }
-        }
-    }
+    float *arrAverageLevels = arrAverageMeterLevels + nFirstChannel;
+    float *arrAveragePeakLevels = arrAverageMeterPeakLevels + nFirstChannel;
+    float *arrAverageLastChanged = arrAverageMeterPeakLastChanged + nFirstChannel;
+
+    float *arrMaximumPeaks = arrMaximumPeakLevels + nFirstChannel;
+    float *arrMaximumTruePeaks = arrMaximumTruePeakLevels + nFirstChannel;
+    int *arrOverflowCounts = arrNumberOfOverflows + nFirstChannel;
 
-    // finally, return new peak level mark
-    return fOutput;
+    for (int n = 0; n < nChannels; ++n)
+    {
+        float fPeak = arrPeakDb[n];
+        float fTruePeak = arrTruePeakDb[n];
+
+        // if current (true) peak meter level exceeds overall maximum
+        // (true) peak level, store it as new overall maximum level
+        arrMaximumPeaks[n] = jmax(arrMaximumPeaks[n], fPeak);
+        arrMaximumTruePeaks[n] = jmax(arrMaximumTruePeaks[n], fTruePeak);
+
+        // apply peak meter's ballistics and store resulting level and
+        // peak mark
+        arrPeakLevels[n] = PeakMeterBallistics(fPeak, arrPeakLevels[n]);
+        arrPeakPeakLevels[n] = PeakMeterPeakBallistics(fTimePassed, arrPeakLastChanged[n], fPeak, arrPeakPeakLevels[n]);
+
+        // apply true peak meter's ballistics and store resulting
+        // level and peak mark
+        arrTruePeakLevels[n] = PeakMeterBallistics(fTruePeak, arrTruePeakLevels[n]);
+        arrTruePeakPeakLevels[n] = PeakMeterPeakBallistics(fTimePassed, arrTruePeakLastChanged[n], fTruePeak, arrTruePeakPeakLevels[n]);
+
+        // apply average meter's ballistics and store resulting level
+        // and peak mark (the peak marks ballistics of peak meter and
+        // average meter are identical)
+        arrAverageLevels[n] = LogMeterBallistics(fAverageAttackReleaseCoef, arrAverageFiltered[n], arrAverageLevels[n]);
+        arrAveragePeakLevels[n] = PeakMeterPeakBallistics(fTimePassed, arrAverageLastChanged[n], arrAverageLevels[n], arrAveragePeakLevels[n]);
+
+        // update registered number of overflows
+        arrOverflowCounts[n] += arrOverflows[n];
+    }
 }
 
 
-void MeterBallistics::AverageMeterBallistics(
-    int nChannel,
-    float fTimePassed,
-    float fAverageLevelCurrent)
-/*  Calculate ballistics for average meter levels and update readout.
+float MeterBallistics::PeakMeterBallistics(
+    float fPeakLevelCurrent,
+    float fPeakLevelOld)
+/*  Calculate ballistics for peak meter levels.
 
-    fTimePassed (float): time that has passed since last update (in
-    fractional seconds)
+    fPeakLevelCurrent (float): current peak meter level in decibel
 
-    fAverageLevelCurrent (float): current average meter level in
-    decibel
+    fPeakLevelOld (float): old peak meter reading in decibel
 
-    return value: none
+    return value (float): new peak meter reading in decibel
 */
 {
-    // meter ballistics: 99% of final reading in 0.6 s (logarithmic)
-    LogMeterBallistics(0.600f, fTimePassed, fAverageLevelCurrent, arrAverageMeterLevels.getReference(nChannel));
+    // immediate rise time; otherwise, apply fall time, but make sure
+    // that meter doesn't fall below current level
+    return jmax(fPeakLevelCurrent, fPeakLevelOld - fPeakReleaseCoef);
 }
 
 
-float MeterBallistics::AverageMeterPeakBallistics(
+float MeterBallistics::PeakMeterPeakBallistics(
     float fTimePassed,
     float &fLastChanged,
     float fPeakCurrent,
     float fPeakOld)
-/*  Calculate ballistics for average meter peak marks.
+/*  Calculate ballistics for peak meter peak marks.  This code has no
+    branches, so that it can be vectorised.
 
     fTimePassed (float): time that has passed since last update (in
     fractional seconds)
@@ -1019,9 +1218,32 @@ float MeterBallistics::AverageMeterPeakBallistics(
     return value (float): new peak level mark in decibel
 */
 {
-    // the peak marks ballistics of peak meter and average meter are
-    // identical, so let's reuse the peak meter code
-    return PeakMeterPeakBallistics(fTimePassed, fLastChanged, fPeakCurrent, fPeakOld);
+    // prevent meter overshoot on overflows by limiting peak levels to
+    // 0.0 dBFS
+    fPeakCurrent = jmin(fPeakCurrent, 0.0f);
+
+    bool bRising = (fPeakCurrent >= fPeakOld);
+
+    // if peak meter is set to "falling peaks" mode (non-negative
+    // values), reset hold time on rising peaks and update it
+    // otherwise (time that peaks are held before starting to fall
+    // back down)
+    bool bFallingPeaks = (fLastChanged >= 0.0f);
+    float fLastChangedNew = bRising ? 0.0f : fLastChanged + fTimePassed;
+    fLastChanged = bFallingPeaks ? fLastChangedNew : fLastChanged;
+
+    // apply fall time (26 dB in 3 seconds, linear), but make sure
+    // that meter doesn't fall below current level
+    float fFalling = jmax(fPeakCurrent, fPeakOld - fPeakReleaseCoef);
+
+    // peak meter is EITHER set to "infinite peak hold" mode (negative
+    // values) OR the peak meter's hold time of 10 seconds has not yet
+    // been exceeded, so retain old peak level mark
+    float fHolding = (fLastChanged < 10.0f) ? fPeakOld : fFalling;
+
+    // immediate rise time, so set current peak level mark as new peak
+    // level mark
+    return bRising ? fPeakCurrent : fHolding;
 }
 
 
@@ -1038,8 +1260,13 @@ void MeterBallistics::StereoMeterBallistics(
     return value: none
 */
 {
+    if (fTimePassed != fStereoCoefficientTimePassed)
+    {
+        UpdateStereoCoefficient(fTimePassed);
+    }
+
     // meter ballistics: 99% of final reading in 1.2 s (logarithmic)
-    LogMeterBallistics(1.200f, fTimePassed, fStereoMeterCurrent, fStereoMeterValue);
+    fStereoMeterValue = LogMeterBallistics(fStereoAttackReleaseCoef, fStereoMeterCurrent, fStereoMeterValue);
 }
 
 
@@ -1058,41 +1285,33 @@ void MeterBallistics::PhaseCorrelationMeterBallistics(
     return value: none
 */
 {
+    if (fTimePassed != fStereoCoefficientTimePassed)
+    {
+        UpdateStereoCoefficient(fTimePassed);
+    }
+
     // meter ballistics: 99% of final reading in 1.2 s (logarithmic)
-    LogMeterBallistics(1.200f, fTimePassed, fPhaseCorrelationCurrent, fPhaseCorrelation);
+    fPhaseCorrelation = LogMeterBallistics(fStereoAttackReleaseCoef, fPhaseCorrelationCurrent, fPhaseCorrelation);
 }
 
 
-void MeterBallistics::LogMeterBallistics(
-    float fMeterInertia,
-    float fTimePassed,
+float MeterBallistics::LogMeterBallistics(
+    float fAttackReleaseCoef,
     float fLevel,
-    float &fReadout)
+    float fReadout)
 /*  Calculate logarithmic meter ballistics.
 
-    fMeterInertia (float): time needed to reach 99% of the final
-    readout (in fractional seconds)
-
-    fTimePassed (float): time that has passed since last update (in
-    fractional seconds)
+    fAttackReleaseCoef (float): attack and release coefficient (see
+    "UpdateCoefficients" and "UpdateStereoCoefficient")
 
     fLevel (float): new meter level
 
-    fReadout (reference to float): old meter readout; this variable
-    will be updated by this function
+    fReadout (float): old meter readout
 
-    return value: none
+    return value (float): new meter readout
 */
 {
-    // we only have to calculate meter ballistics if meter level and
-    // meter readout are not equal
-    if (fLevel != fReadout)
-    {
-        // Thanks to Bram de Jong for the code snippet!
-        // (http://www.musicdsp.org/showone.php?id=136)
-        //
-        // rise and fall: 99% of final reading in "fMeterInertia" seconds
-        float fAttackReleaseCoef = powf(0.01f, fTimePassed / fMeterInertia);
-        fReadout = fAttackReleaseCoef * (fReadout - fLevel) + fLevel;
-    }
+    // if meter level and meter readout are equal, this simply returns
+    // the old readout
+    return fAttackReleaseCoef * (fReadout - fLevel) + fLevel;
 }
@@ -41,7 +41,9 @@ public:
     void setAverageAlgorithm(int AverageAlgorithm);
     void setPeakMeterInfiniteHold(bool bInfiniteHold);
     void setAverageMeterInfiniteHold(bool bInfiniteHold);
+    void setExactConversion(bool bExact);
     void reset();
+    void resetMeterLevels();
 
     int getNumberOfChannels();
 
@@ -73,59 +75,98 @@ public:
                        float fAverageFiltered,
                        int nOverflows);
 
+    void updateChannels(float fTimePassed,
+                        const float *arrPeak,
+                        const float *arrTruePeak,
+                        const float *arrAverageFiltered,
+                        const int *arrOverflows);
+
+    void updateMaxima(const float *arrPeak,
+                      const float *arrTruePeak,
+                      const int *arrOverflows);
+
     static float level2decibel(float fLevel);
     static double decibel2level_double(double dDecibels);
 
     static float decibel2level(float fDecibels);
     static double level2decibel_double(double dLevel);
 
+    static float level2decibel_fast(float fLevel);
+
     static float getMeterMinimumDecibel();
 private:
     JUCE_LEAK_DETECTOR(MeterBallistics);
 
     int nNumberOfChannels;
     int nAverageAlgorithm;
+    bool bExactConversion;
 
     static float fMeterMinimumDecibel;
     static float fPeakToAverageCorrection;
 
-    Array<float> arrPeakMeterLevels;
-    Array<float> arrPeakMeterPeakLevels;
+    // all channel readings are stored in a single block of memory
+    // (one array per reading); every array starts on a cache line
+    // and holds "nChannelStride" values
+    int nChannelStride;
+    HeapBlock<float> arrStateMemory;
+
+    float *arrPeakMeterLevels;
+    float *arrPeakMeterPeakLevels;
 
-    Array<float> arrTruePeakMeterLevels;
-    Array<float> arrTruePeakMeterPeakLevels;
+    float *arrTruePeakMeterLevels;
+    float *arrTruePeakMeterPeakLevels;
 
-    Array<float> arrAverageMeterLevels;
-    Array<float> arrAverageMeterPeakLevels;
+    float *arrAverageMeterLevels;
+    float *arrAverageMeterPeakLevels;
 
-    Array<float> arrMaximumPeakLevels;
-    Array<float> arrMaximumTruePeakLevels;
-    Array<int> arrNumberOfOverflows;
+    float *arrMaximumPeakLevels;
+    float *arrMaximumTruePeakLevels;
 
-    Array<float> arrPeakMeterPeakLastChanged;
-    Array<float> arrTruePeakMeterPeakLastChanged;
-    Array<float> arrAverageMeterPeakLastChanged;
+    float *arrPeakMeterPeakLastChanged;
+    float *arrTruePeakMeterPeakLastChanged;
+    float *arrAverageMeterPeakLastChanged;
+
+    float *arrPeakDecibels;
+    float *arrTruePeakDecibels;
+
+    HeapBlock<int> arrNumberOfOverflows;
 
     float fStereoMeterValue;
     float fPhaseCorrelation;
 
-    float PeakMeterBallistics(float fTimePassed,
-                              float fPeakLevelCurrent,
+    // ballistics coefficients only depend on the time that has
+    // passed since the last update, which rarely changes
+    float fCoefficientsTimePassed;
+    float fPeakReleaseCoef;
+    float fAverageAttackReleaseCoef;
+
+    // stereo meters may be updated at a different rate
+    float fStereoCoefficientTimePassed;
+    float fStereoAttackReleaseCoef;
+
+    void UpdateCoefficients(float fTimePassed);
+    void UpdateStereoCoefficient(float fTimePassed);
+
+    void ConvertToDecibels(int nFirstChannel,
+                           int nChannels,
+                           const float *arrPeak,
+                           const float *arrTruePeak);
+
+    void ApplyBallistics(int nFirstChannel,
+                         int nChannels,
+                         float fTimePassed,
+                         const float *arrPeak,
+                         const float *arrTruePeak,
+                         const float *arrAverageFiltered,
+                         const int *arrOverflows);
+
+    float PeakMeterBallistics(float fPeakLevelCurrent,
                               float fPeakLevelOld);
 
     float PeakMeterPeakBallistics(float fTimePassed,
                                   float &fLastChanged,
-                                  float fPeakLevelCurrent,
-                                  float fPeakLevelOld);
-
-    void AverageMeterBallistics(int nChannel,
-                                float fTimePassed,
-                                float fAverageLevelCurrent);
-
-    float AverageMeterPeakBallistics(float fTimePassed,
-                                     float &fLastChanged,
-                                     float fAverageLevelCurrent,
-                                     float fAverageLevelOld);
+                                  float fPeakCurrent,
+                                  float fPeakOld);
 
     void StereoMeterBallistics(float fTimePassed,
                                float fStereoMeterCurrent);
@@ -133,10 +174,9 @@ private:
     void PhaseCorrelationMeterBallistics(float fTimePassed,
                                          float fPhaseCorrelationCurrent);
 
-    void LogMeterBallistics(float fMeterInertia,
-                            float fTimePassed,
-                            float fLevel,
-                            float &fReadout);
+    float LogMeterBallistics(float fAttackReleaseCoef,
+                             float fLevel,
+                             float fReadout);
 };
 
 #endif  // KMETER_METER_BALLISTICS_H
@@ -34,6 +34,9 @@ void MeterBar::create(
 {
     frut::widgets::MeterBar::create();
 
+    // draw all segments in a single component
+    setSingleComponent(true);
+
     crestFactor *= 10;
     int numberOfBars;
 
@@ -287,4 +290,7 @@ void MeterBar::create(
 
     // set orientation here to save some processing power
     setOrientation(orientation);
+
+    // look up dirty pixels instead of repainting the whole bar
+    buildLevelTable();
 }
@@ -35,6 +35,20 @@ PeakLabel::PeakLabel(int nCrestFactor)
 }
 
 
+void PeakLabel::setCrestFactor(int nCrestFactor)
+{
+    if (nCrestFactor == nMeterCrestFactor)
+    {
+        return;
+    }
+
+    nMeterCrestFactor = nCrestFactor;
+
+    // ensure peak label update on next call of updateLevel()
+    fMaximumLevel -= 0.1f;
+}
+
+
 void PeakLabel::resetLevel()
 {
     float fMaximumCrestFactor = 20.0f; // i.e. K-20
@@ -35,6 +35,8 @@ class PeakLabel :
 public:
     explicit PeakLabel(int nCrestFactor);
 
+    void setCrestFactor(int nCrestFactor);
+
     void resetLevel();
     void updateLevel(float newLevel);
 
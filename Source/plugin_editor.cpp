@@ -53,7 +53,7 @@ static void window_validation_callback(int modalResult, KmeterAudioProcessorEdit
 }
 
 
-KmeterAudioProcessorEditor::KmeterAudioProcessorEditor(KmeterAudioProcessor *ownerFilter, int nNumChannels)
+KmeterAudioProcessorEditor::KmeterAudioProcessorEditor(KmeterAudioProcessor *ownerFilter, const AudioChannelSet &channelSet)
     : AudioProcessorEditor(ownerFilter)
 {
     // load look and feel
@@ -69,7 +69,8 @@ KmeterAudioProcessorEditor::KmeterAudioProcessorEditor(KmeterAudioProcessor *own
     isValidating = false;
     validationDialogOpen = false;
 
-    numberOfInputChannels_ = nNumChannels;
+    channelSet_ = channelSet;
+    numberOfInputChannels_ = channelSet.size();
     crestFactor = 0;
 
     isExpanded = false;
@@ -168,6 +169,28 @@ KmeterAudioProcessorEditor::KmeterAudioProcessorEditor(KmeterAudioProcessor *own
         addAndMakeVisible(phaseCorrelationMeter);
     }
 
+    // only shown while the CPU governor has stepped down optional
+    // processing stages
+    LabelDegraded.setText("CPU", dontSendNotification);
+    LabelDegraded.setTooltip("CPU budget exceeded: reduced true peak oversampling and stereo meter rate");
+    LabelDegraded.setJustificationType(Justification::centred);
+    LabelDegraded.setFont(Font(11.0f, Font::bold));
+    LabelDegraded.setColour(Label::textColourId, Colours::black);
+    LabelDegraded.setColour(Label::backgroundColourId, Colours::orange);
+    addChildComponent(LabelDegraded);
+
+    // processing load of this instance relative to the host's
+    // deadline
+    LabelLoad.setTooltip("processing load: average / 99th percentile / maximum (callbacks over " +
+                         String(roundToInt(100.0f * audioProcessor->getLoadMonitorDeadlineFraction())) +
+                         " % of the deadline)");
+    LabelLoad.setJustificationType(Justification::centredLeft);
+    LabelLoad.setFont(Font(11.0f));
+    LabelLoad.setColour(Label::textColourId, Colours::grey);
+    addAndMakeVisible(LabelLoad);
+
+    loadUpdateTime_ = Time::getMillisecondCounter();
+
     updateParameter(KmeterPluginParameters::selCrestFactor);
     updateParameter(KmeterPluginParameters::selAverageAlgorithm);
 
@@ -190,11 +213,17 @@ KmeterAudioProcessorEditor::KmeterAudioProcessorEditor(KmeterAudioProcessor *own
     // apply skin to plug-in editor
     currentSkinName = audioProcessor->getParameterSkinName();
     loadSkin();
+
+    // poll for new meter readings and animate meters at display
+    // rate
+    needleAnimation_.reset(numberOfAnimatedNeedles, 0.5f);
+    startTimerHz(60);
 }
 
 
 KmeterAudioProcessorEditor::~KmeterAudioProcessorEditor()
 {
+    stopTimer();
     audioProcessor->removeActionListener(this);
 
     // release look and feel
@@ -206,7 +235,9 @@ void KmeterAudioProcessorEditor::loadSkin()
 {
     File fileSkin = skinDirectory.getChildFile(currentSkinName + ".skin");
 
-    if (!fileSkin.existsAsFile())
+    // skins may also be shipped in compiled form only
+    if ((!fileSkin.existsAsFile()) &&
+            (!fileSkin.withFileExtension("skinbundle").existsAsFile()))
     {
         Logger::outputDebugString("[Skin] file \"" + fileSkin.getFileName() + "\" not found");
 
@@ -214,8 +245,14 @@ void KmeterAudioProcessorEditor::loadSkin()
         fileSkin = skinDirectory.getChildFile(currentSkinName + ".skin");
     }
 
+    // without a skin directory (or if the skin is broken), the
+    // default skin that has been compiled into the plug-in is used
     audioProcessor->setParameterSkinName(currentSkinName);
-    skin.loadSkin(fileSkin, numberOfInputChannels_, crestFactor, audioProcessor->getAverageAlgorithm(), isExpanded, usePeakMeter);
+
+    if (!skin.loadSkin(fileSkin, numberOfInputChannels_, crestFactor, audioProcessor->getAverageAlgorithm(), isExpanded, usePeakMeter))
+    {
+        Logger::outputDebugString("[Skin] no skin could be loaded");
+    }
 
     // will also apply skin to plug-in editor
     needsMeterReload = true;
@@ -238,6 +275,11 @@ void KmeterAudioProcessorEditor::applySkin()
     // will also resize plug-in editor
     skin.setBackgroundImage(&BackgroundImage, this);
 
+    skin.placeAndSkinTextLabel("label_degraded",
+                               &LabelDegraded);
+    skin.placeAndSkinTextLabel("label_load",
+                               &LabelLoad);
+
     skin.placeAndSkinButton("button_k20",
                             &ButtonK20);
     skin.placeAndSkinButton("button_k14",
@@ -339,53 +381,131 @@ void KmeterAudioProcessorEditor::windowValidationCallback(int modalResult)
 }
 
 
-void KmeterAudioProcessorEditor::actionListenerCallback(const String &strMessage)
+void KmeterAudioProcessorEditor::timerCallback()
 {
-    // "PC" ==> parameter changed, followed by a hash and the
-    // parameter's ID
-    if (strMessage.startsWith("PC#"))
+    // the audio thread only flags new meter readings, so it never
+    // has to allocate or post messages
+    if (audioProcessor->hasNewMeterReadings())
     {
-        String strIndex = strMessage.substring(3);
-        int nIndex = strIndex.getIntValue();
-        jassert(nIndex >= 0);
-        jassert(nIndex < audioProcessor->getNumParameters());
+        updateMeters();
+    }
 
-        if (audioProcessor->hasChanged(nIndex))
+    // parameter changes are flagged in the same way
+    if (audioProcessor->hasChangedParameters())
+    {
+        for (int nIndex = 0; nIndex < audioProcessor->getNumParameters(); ++nIndex)
         {
-            updateParameter(nIndex);
+            if (audioProcessor->hasChanged(nIndex))
+            {
+                updateParameter(nIndex);
+            }
         }
     }
-    // "UM" ==> update meters
-    else if (!strMessage.compare("UM"))
+
+    if (audioProcessor->hasChangedAverageAlgorithm())
     {
-        std::shared_ptr<MeterBallistics> pMeterBallistics = audioProcessor->getLevels();
+        updateAverageAlgorithm(true);
+    }
 
-        if (pMeterBallistics != nullptr)
-        {
-            kmeter_.setLevels(pMeterBallistics);
+    // meter readings arrive at chunk rate, so interpolate between
+    // them on every frame; repaints are thus bounded by the timer
+    // rate
+    animateMeters();
+}
 
-            if (numberOfInputChannels_ <= 2)
-            {
-                float fStereo = pMeterBallistics->getStereoMeterValue();
-                stereoMeter.setValue(fStereo / 2.0f + 0.5f);
 
-                float fPhase = pMeterBallistics->getPhaseCorrelation();
-                phaseCorrelationMeter.setValue(fPhase / 2.0f + 0.5f);
-            }
-        }
+void KmeterAudioProcessorEditor::updateMeters()
+{
+    std::shared_ptr<MeterBallistics> pMeterBallistics = audioProcessor->getLevels();
 
-        if (isValidating && !audioProcessor->isValidating())
-        {
-            isValidating = false;
-        }
+    if (pMeterBallistics != nullptr)
+    {
+        setLevels(pMeterBallistics);
     }
-    // "AC" ==> algorithm changed
-    else if (!strMessage.compare("AC"))
+
+    LabelDegraded.setVisible(audioProcessor->isProcessingDegraded());
+
+    // update load readout twice a second
+    uint32 currentTime = Time::getMillisecondCounter();
+
+    if ((currentTime - loadUpdateTime_) >= 500)
     {
-        updateAverageAlgorithm(true);
+        loadUpdateTime_ = currentTime;
+
+        frut::audio::LoadMonitor::Statistics load =
+            audioProcessor->getProcessingLoad();
+
+        LabelLoad.setText(String(100.0f * load.averageLoad, 1) + " / " +
+                          String(100.0f * load.percentileLoad, 1) + " / " +
+                          String(100.0f * load.maximumLoad, 1) + " %  (" +
+                          String(load.deadlineMisses) + " over)",
+                          dontSendNotification);
+    }
+
+    if (isValidating && !audioProcessor->isValidating())
+    {
+        isValidating = false;
     }
+}
+
+
+/// Hand meter readings to all meters; they are animated towards the
+/// new readings at display rate.
+///
+/// @param meterBallistics meter readings
+///
+void KmeterAudioProcessorEditor::setLevels(
+    std::shared_ptr<MeterBallistics> meterBallistics)
+{
+    kmeter_.setLevels(meterBallistics);
+
+    if (numberOfInputChannels_ <= 2)
+    {
+        needleAnimation_.beginSnapshot();
+
+        float fStereo = meterBallistics->getStereoMeterValue();
+        needleAnimation_.setTarget(stereoNeedle,
+                                   fStereo / 2.0f + 0.5f,
+                                   false);
+
+        float fPhase = meterBallistics->getPhaseCorrelation();
+        needleAnimation_.setTarget(phaseCorrelationNeedle,
+                                   fPhase / 2.0f + 0.5f,
+                                   false);
+    }
+}
+
+
+/// Display meter readings at once, without animation.  This allows
+/// rendering the editor without a running processor.
+///
+/// @param meterBallistics meter readings
+///
+void KmeterAudioProcessorEditor::showLevels(
+    std::shared_ptr<MeterBallistics> meterBallistics)
+{
+    setLevels(meterBallistics);
+    kmeter_.skipAnimation();
+
+    if (numberOfInputChannels_ <= 2)
+    {
+        needleAnimation_.skip();
+
+        stereoMeter.setValue(
+            needleAnimation_.getValue(stereoNeedle));
+        phaseCorrelationMeter.setValue(
+            needleAnimation_.getValue(phaseCorrelationNeedle));
+    }
+}
+
+
+void KmeterAudioProcessorEditor::actionListenerCallback(const String &strMessage)
+{
+    // changes of parameters and averaging algorithm are polled in
+    // "timerCallback"
+    //
     // "V+" ==> validation started
-    else if ((!strMessage.compare("V+")) && audioProcessor->isValidating())
+    if ((!strMessage.compare("V+")) && audioProcessor->isValidating())
     {
         isValidating = true;
     }
@@ -406,6 +526,22 @@ void KmeterAudioProcessorEditor::actionListenerCallback(const String &strMessage
 }
 
 
+void KmeterAudioProcessorEditor::animateMeters()
+{
+    kmeter_.animate();
+
+    if (numberOfInputChannels_ <= 2)
+    {
+        needleAnimation_.advance();
+
+        stereoMeter.setValue(
+            needleAnimation_.getValue(stereoNeedle));
+        phaseCorrelationMeter.setValue(
+            needleAnimation_.getValue(phaseCorrelationNeedle));
+    }
+}
+
+
 void KmeterAudioProcessorEditor::updateParameter(int nIndex)
 {
     int nValue = audioProcessor->getRealInteger(nIndex);
@@ -534,14 +670,15 @@ void KmeterAudioProcessorEditor::reloadMeters()
     {
         needsMeterReload = false;
 
-        int numberOfInputChannels = numberOfInputChannels_;
+        AudioChannelSet channelSet = channelSet_;
 
+        // ITU-R BS.1770-1 only has a single meter
         if (audioProcessor->getAverageAlgorithm() == KmeterPluginParameters::selAlgorithmItuBs1770)
         {
-            numberOfInputChannels = 1;
+            channelSet = AudioChannelSet::mono();
         }
 
-        kmeter_.create(numberOfInputChannels);
+        kmeter_.create(channelSet);
 
         bool isAttenuated = ButtonDim.getToggleState() |
                             ButtonMute.getToggleState();
@@ -555,6 +692,9 @@ void KmeterAudioProcessorEditor::reloadMeters()
 
 void KmeterAudioProcessorEditor::paint(Graphics &g)
 {
+    FRUT_PROFILE_INSTANCE(audioProcessor);
+    FRUT_PROFILE_SCOPE("KmeterAudioProcessorEditor::paint");
+
     g.fillAll(Colours::black);
 }
 
@@ -618,6 +758,18 @@ void KmeterAudioProcessorEditor::buttonClicked(Button *button)
     {
         audioProcessor->resetMeters();
 
+#if FRUT_AUDIO_USE_PROFILER
+        // dump profiling data of all instances (load into Perfetto)
+        File traceFile = File::getSpecialLocation(File::tempDirectory)
+                         .getChildFile("kmeter_trace.json");
+
+        if (frut::audio::Profiler::writeChromeTrace(traceFile))
+        {
+            Logger::outputDebugString("[K-Meter] profiling data written to " +
+                                      traceFile.getFullPathName());
+        }
+#endif
+
         // apply skin to plug-in editor
         loadSkin();
     }
@@ -36,15 +36,18 @@
 class KmeterAudioProcessorEditor :
     public AudioProcessorEditor,
     public Button::Listener,
-    public ActionListener
+    public ActionListener,
+    public Timer
 {
 public:
-    KmeterAudioProcessorEditor(KmeterAudioProcessor *ownerFilter, int nNumChannels);
+    KmeterAudioProcessorEditor(KmeterAudioProcessor *ownerFilter, const AudioChannelSet &channelSet);
     ~KmeterAudioProcessorEditor();
 
     void buttonClicked(Button *button);
     void actionListenerCallback(const String &message);
+    void timerCallback() override;
     void updateParameter(int nIndex);
+    void showLevels(std::shared_ptr<MeterBallistics> meterBallistics);
 
     void windowAboutCallback(int modalResult);
     void windowSkinCallback(int modalResult);
@@ -57,7 +60,18 @@ public:
 private:
     JUCE_LEAK_DETECTOR(KmeterAudioProcessorEditor);
 
+    // needle positions that are animated at display rate
+    enum animatedNeedle  // private namespace
+    {
+        stereoNeedle = 0,
+        phaseCorrelationNeedle,
+        numberOfAnimatedNeedles
+    };
+
     void reloadMeters();
+    void updateMeters();
+    void setLevels(std::shared_ptr<MeterBallistics> meterBallistics);
+    void animateMeters();
     void applySkin();
     void loadSkin();
     void updateAverageAlgorithm(bool reload_meters);
@@ -71,6 +85,7 @@ private:
 
     int crestFactor;
     int numberOfInputChannels_;
+    AudioChannelSet channelSet_;
 
     File skinDirectory;
     Skin skin;
@@ -80,6 +95,7 @@ private:
     Kmeter kmeter_;
     frut::widgets::NeedleMeter stereoMeter;
     frut::widgets::NeedleMeter phaseCorrelationMeter;
+    frut::widgets::SnapshotInterpolator needleAnimation_;
 
     frut::skin::LookAndFeel_Frut_V3 customLookAndFeel_;
 
@@ -110,6 +126,10 @@ private:
     ImageComponent LabelDebug;
 #endif
 
+    Label LabelDegraded;
+    Label LabelLoad;
+    uint32 loadUpdateTime_;
+
     ImageComponent BackgroundImage;
 };
 
@@ -84,6 +84,17 @@ public:
         nNumAlgorithms,
     };
 
+    // channel count of the current build target; metering code is
+    // specialised for it at compile time
+#ifdef KMETER_SURROUND
+    static const int nNumChannels = 6;
+#else
+    static const int nNumChannels = 2;
+#endif
+
+    // maximum number of channels on the main bus
+    static const int nNumChannelsMaximum = 16;
+
 private:
     JUCE_LEAK_DETECTOR(KmeterPluginParameters);
 };
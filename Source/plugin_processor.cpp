@@ -61,8 +61,13 @@ KmeterAudioProcessor::KmeterAudioProcessor() :
     }
 
     meterBallistics_ = nullptr;
+    parallelTruePeakMeter_ = nullptr;
+    offlineTruePeakMeter_ = nullptr;
+    isOfflineRendering_ = false;
     averageLevelFiltered_ = nullptr;
     truePeakMeter_ = nullptr;
+    truePeakMeterReduced_ = nullptr;
+    activeTruePeakMeter_ = nullptr;
 
     ringBuffer_ = nullptr;
     ringBufferDouble_ = nullptr;
@@ -77,6 +82,11 @@ KmeterAudioProcessor::KmeterAudioProcessor() :
 
     outputGain_ = 1.0;
     outputFadeRate_ = 0.0;
+    outputFadeFactor_ = 1.0;
+
+    preparedNumberOfChannels_ = -1;
+    preparedSampleRate_ = -1.0;
+    preparedOversamplingFactor_ = -1;
 
     // compensate for pre-delay
     setLatencySamples(kmeterBufferSize_);
@@ -86,6 +96,18 @@ KmeterAudioProcessor::KmeterAudioProcessor() :
                               KmeterPluginParameters::selAverageAlgorithm);
 
     processedSeconds_ = 0.0f;
+
+    silentChunks_ = 0;
+    silentChunksUntilBypass_ = 0;
+
+    isEditorOpen_ = false;
+    isReducingWork_ = false;
+    hasNewMeterReadings_ = false;
+    hasChangedParameters_ = false;
+    hasChangedAverageAlgorithm_ = false;
+
+    isDegraded_ = false;
+    skipStereoUpdate_ = false;
 }
 
 
@@ -135,12 +157,23 @@ bool KmeterAudioProcessor::isBusesLayoutSupported(
 
 #ifdef KMETER_SURROUND
 
+    int numberOfChannels = layouts.getMainInputChannelSet().size();
+
     // main bus with 5.1 input ==> okay
     if (layouts.getMainInputChannelSet() == AudioChannelSet::create5point1())
     {
         return true;
     }
 
+    // main bus with any other multi-channel layout (such as 7.1,
+    // 7.1.4 or Ambisonics) ==> okay; channel weights and meter
+    // placement are derived from the channel types
+    if ((numberOfChannels > 2) &&
+            (numberOfChannels <= KmeterPluginParameters::nNumChannelsMaximum))
+    {
+        return true;
+    }
+
 #else
 
     // main bus with stereo input ==> okay
@@ -276,9 +309,10 @@ void KmeterAudioProcessor::setParameter(
                 setAverageAlgorithm(getRealInteger(nIndex));
             }
 
-            // "PC" ==> parameter changed, followed by a hash and the
-            // parameter's ID
-            sendActionMessage("PC#" + String(nIndex));
+            // the editor polls this flag and then updates all
+            // changed parameters; unlike action messages, this
+            // neither allocates nor locks
+            hasChangedParameters_ = true;
         }
         // for hidden parameters, we only have to clear the change
         // flag
@@ -491,94 +525,227 @@ void KmeterAudioProcessor::prepareToPlay(
     }
 
     isSilent_ = false;
-    hasStopped_ = true;
 
-    // force initialization of "outputGain_" in "processBlock()"
-    currentAttenuationDecibel_ = attenuationDecibel_ + 1e-12;
+    int numInputChannels = getMainBusNumInputChannels();
+    AudioChannelSet inputChannelSet = getChannelLayoutOfBus(true, 0);
 
-    // output fade rate: 60 dB/s
-    outputFadeRate_ = 60.0 / sampleRate;
+    // make sure that ring buffer can hold at least kmeterBufferSize_
+    // samples and is large enough to receive a full block of audio
+    int ringBufferSize = jmax(samplesPerBlock, kmeterBufferSize_);
 
-    int numInputChannels = getMainBusNumInputChannels();
+    // lower the oversampling factor for high sample rates to save
+    // processing time (offline rendering has its own true peak
+    // meter that always uses the highest factor)
+    int oversamplingFactor = maximumOversamplingFactor_;
+
+    if (sampleRate >= 176400)
+    {
+        oversamplingFactor /= 4;
+    }
+    else if (sampleRate >= 88200)
+    {
+        oversamplingFactor /= 2;
+    }
 
-    dither_.initialise(jmax(getMainBusNumInputChannels(),
-                            getMainBusNumOutputChannels()),
-                       24);
+    // hosts call this method quite often, so only re-create what
+    // actually depends on a changed setting; everything else
+    // (including the meter readings) is kept
+    bool channelsChanged = (meterBallistics_ == nullptr) ||
+                           (numInputChannels != preparedNumberOfChannels_) ||
+                           (inputChannelSet != preparedChannelSet_);
 
-    Logger::outputDebugString("[K-Meter] number of input channels: " +
-                              String(numInputChannels));
-    Logger::outputDebugString("[K-Meter] number of output channels: " +
-                              String(getMainBusNumOutputChannels()));
+    bool sampleRateChanged = channelsChanged ||
+                             (averageLevelFiltered_ == nullptr) ||
+                             (sampleRate != preparedSampleRate_);
 
-    isStereo_ = (numInputChannels == 2);
+    bool oversamplingChanged = channelsChanged ||
+                               (truePeakMeter_ == nullptr) ||
+                               (oversamplingFactor != preparedOversamplingFactor_);
 
-    meterBallistics_ = std::make_shared<MeterBallistics>(
-                           numInputChannels,
-                           averageAlgorithmId_,
-                           false,
-                           false);
+    bool ringBufferTooSmall = channelsChanged ||
+                              (ringBuffer_ == nullptr) ||
+                              (ringBufferSize > ringBuffer_->getNumberOfSamples());
 
-    peakLevels_.clear();
-    rmsLevels_.clear();
-    averageLevelsFiltered_.clear();
-    truePeakLevels_.clear();
+    preparedNumberOfChannels_ = numInputChannels;
+    preparedChannelSet_ = inputChannelSet;
+    preparedSampleRate_ = sampleRate;
+    preparedOversamplingFactor_ = oversamplingFactor;
 
-    overflowCounts_.clear();
+    if (sampleRateChanged)
+    {
+        // output fade rate: 60 dB/s
+        outputFadeRate_ = 60.0 / sampleRate;
+
+        // gain ratio of two consecutive samples during a fade in
+        outputFadeFactor_ = MeterBallistics::decibel2level_double(
+                                outputFadeRate_);
+
+        // after half a second of digital silence, the tails of all
+        // filters (38 Hz high-pass included) have decayed far below
+        // the meter's minimum level
+        silentChunksUntilBypass_ = jmax(4, roundToInt(
+                                            0.5 * sampleRate / kmeterBufferSize_));
+        silentChunks_ = 0;
+    }
 
-    for (int channel = 0; channel < numInputChannels; ++channel)
+    if (channelsChanged)
     {
-        peakLevels_.add(0.0f);
-        rmsLevels_.add(0.0f);
-        averageLevelsFiltered_.add(MeterBallistics::getMeterMinimumDecibel());
-        truePeakLevels_.add(0.0f);
+        Logger::outputDebugString("[K-Meter] number of input channels: " +
+                                  String(numInputChannels) + " (" +
+                                  inputChannelSet.getDescription() + ")");
+        Logger::outputDebugString("[K-Meter] number of output channels: " +
+                                  String(getMainBusNumOutputChannels()));
+
+        hasStopped_ = true;
+        isStereo_ = (numInputChannels == 2);
+
+        dither_.initialise(jmax(getMainBusNumInputChannels(),
+                                getMainBusNumOutputChannels()),
+                           24);
+
+        meterBallistics_ = std::make_shared<MeterBallistics>(
+                               numInputChannels,
+                               averageAlgorithmId_,
+                               false,
+                               false);
 
-        overflowCounts_.add(0);
+        peakLevels_.clear();
+        rmsLevels_.clear();
+        averageLevelsFiltered_.clear();
+        truePeakLevels_.clear();
+
+        overflowCounts_.clear();
+
+        for (int channel = 0; channel < numInputChannels; ++channel)
+        {
+            peakLevels_.add(0.0f);
+            rmsLevels_.add(0.0f);
+            averageLevelsFiltered_.add(MeterBallistics::getMeterMinimumDecibel());
+            truePeakLevels_.add(0.0f);
+
+            overflowCounts_.add(0);
+        }
     }
 
-    averageLevelFiltered_ = std::make_unique<AverageLevelFiltered>(
-                                numInputChannels,
-                                (int) sampleRate,
-                                kmeterBufferSize_,
-                                averageAlgorithmId_);
+    if (sampleRateChanged)
+    {
+        Logger::outputDebugString("[K-Meter] preparing average filter");
 
-    // maximum under-read of true peak measurement is 0.169 dB (see
-    // Annex 2 of ITU-R BS.1770-4)
-    int oversamplingFactor = 8;
+        averageLevelFiltered_ = std::make_unique<AverageLevelFiltered>(
+                                    inputChannelSet,
+                                    (int) sampleRate,
+                                    kmeterBufferSize_,
+                                    averageAlgorithmId_);
+    }
 
-    if (sampleRate >= 176400)
+    if (oversamplingChanged)
     {
-        oversamplingFactor /= 4;
+        Logger::outputDebugString("[K-Meter] preparing true peak meter");
+
+        truePeakMeter_ = std::make_unique<frut::dsp::TruePeakMeter>(
+                             numInputChannels,
+                             kmeterBufferSize_,
+                             oversamplingFactor);
+
+        // the CPU governor may switch to half the oversampling
+        // factor at any time, so prepare this meter in advance
+        if (oversamplingFactor > 2)
+        {
+            truePeakMeterReduced_ = std::make_unique<frut::dsp::TruePeakMeter>(
+                                        numInputChannels,
+                                        kmeterBufferSize_,
+                                        oversamplingFactor / 2);
+        }
+        else
+        {
+            truePeakMeterReduced_ = nullptr;
+        }
+
+        activeTruePeakMeter_ = truePeakMeter_.get();
+        isDegraded_ = false;
     }
-    else if (sampleRate >= 88200)
+
+    if (channelsChanged)
     {
-        oversamplingFactor /= 2;
+        Logger::outputDebugString("[K-Meter] preparing offline analysis");
+
+        // stop old workers before starting new ones
+        offlineTruePeakMeter_ = nullptr;
+        parallelTruePeakMeter_ = nullptr;
+
+        // the calling thread determines the average levels in the
+        // meantime, so leave one core for it
+        int numberOfWorkers = jmax(1, SystemStats::getNumCpus() - 1);
+        int maximumOversamplingFactor = maximumOversamplingFactor_;
+
+        // offline rendering may start at any time, so prepare its
+        // meter in advance (idle workers fall asleep)
+        parallelTruePeakMeter_ = std::make_unique<frut::dsp::TruePeakMeterParallel>(
+                                     numInputChannels,
+                                     kmeterBufferSize_,
+                                     maximumOversamplingFactor,
+                                     numberOfWorkers);
     }
 
-    truePeakMeter_ = std::make_unique<frut::dsp::TruePeakMeter>(
-                         numInputChannels,
-                         kmeterBufferSize_,
-                         oversamplingFactor);
+    // "processBufferChunk" switches to the offline meter as needed
+    offlineTruePeakMeter_ = nullptr;
 
-    // make sure that ring buffer can hold at least kmeterBufferSize_
-    // samples and is large enough to receive a full block of audio
-    int ringBufferSize = jmax(samplesPerBlock, kmeterBufferSize_);
+    if (ringBufferTooSmall)
+    {
+        Logger::outputDebugString("[K-Meter] preparing ring buffers");
+
+        int preDelay = kmeterBufferSize_;
+        int chunkSize = kmeterBufferSize_;
 
-    int preDelay = kmeterBufferSize_;
-    int chunkSize = kmeterBufferSize_;
+        ringBuffer_ = std::make_unique<frut::audio::RingBuffer<float>>(
+                          numInputChannels,
+                          ringBufferSize,
+                          preDelay,
+                          chunkSize);
 
-    ringBuffer_ = std::make_unique<frut::audio::RingBuffer<float>>(
-                      numInputChannels,
-                      ringBufferSize,
-                      preDelay,
-                      chunkSize);
+        ringBuffer_->setCallbackClass(this);
+
+        ringBufferDouble_ = std::make_unique<frut::audio::RingBuffer<double>>(
+                                numInputChannels,
+                                ringBufferSize,
+                                preDelay,
+                                chunkSize);
+    }
+    else
+    {
+        // re-used ring buffers still hold the pre-delay of the last
+        // playback, which must not reach the outputs
+        ringBuffer_->clear();
+        ringBufferDouble_->clear();
+    }
+
+    // likewise, re-used analysers must not start with the filter
+    // state of the last playback (meter readings are kept, though)
+    if (!sampleRateChanged)
+    {
+        averageLevelFiltered_->reset();
+    }
+
+    if (!oversamplingChanged)
+    {
+        truePeakMeter_->reset();
+
+        if (truePeakMeterReduced_ != nullptr)
+        {
+            truePeakMeterReduced_->reset();
+        }
+    }
 
-    ringBuffer_->setCallbackClass(this);
+    if (!channelsChanged)
+    {
+        parallelTruePeakMeter_->reset();
+    }
 
-    ringBufferDouble_ = std::make_unique<frut::audio::RingBuffer<double>>(
-                            numInputChannels,
-                            ringBufferSize,
-                            preDelay,
-                            chunkSize);
+    // temporary buffer for double precision processing; allocate it
+    // here so that "processBlock" does not have to
+    processBuffer_.setSize(jmax(getTotalNumInputChannels(),
+                                getTotalNumOutputChannels()),
+                           samplesPerBlock);
 }
 
 
@@ -590,14 +757,17 @@ void KmeterAudioProcessor::releaseResources()
     Logger::outputDebugString("[K-Meter] releasing resources");
     Logger::outputDebugString("");
 
-    hasStopped_ = true;
+    // hosts call this method whenever playback stops, so keep the
+    // meter ballistics, analysers and ring buffers; "prepareToPlay"
+    // re-uses them unless the configuration changes, and the
+    // destructor finally frees them (idle workers of the offline
+    // true peak meter fall asleep)
 
-    meterBallistics_ = nullptr;
-    averageLevelFiltered_ = nullptr;
-    truePeakMeter_ = nullptr;
+    // stop counting towards the process-wide CPU budget
+    cpuGovernor_.reset();
 
-    ringBuffer_ = nullptr;
-    ringBufferDouble_ = nullptr;
+    activeTruePeakMeter_ = truePeakMeter_.get();
+    isDegraded_ = false;
 }
 
 
@@ -609,11 +779,31 @@ void KmeterAudioProcessor::reset()
 
     hasStopped_ = true;
     processedSeconds_ = 0.0f;
+    silentChunks_ = 0;
 
     ringBuffer_->clear();
 
     averageLevelFiltered_->reset();
-    truePeakMeter_->reset();
+    activeTruePeakMeter_->reset();
+    parallelTruePeakMeter_->reset();
+}
+
+
+/// Called by the host before and after offline rendering, which may
+/// happen at any time (even after "prepareToPlay" and from the audio
+/// thread).  Offline rendering has no deadline, so true peak levels
+/// are then measured with the highest oversampling factor on worker
+/// threads.  The meters are prepared in "prepareToPlay" and switched
+/// on the next chunk, so this function neither allocates nor locks.
+///
+/// @param nonRealtime true if the host is about to render offline
+///
+void KmeterAudioProcessor::setNonRealtime(
+    bool nonRealtime) noexcept
+{
+    AudioProcessor::setNonRealtime(nonRealtime);
+
+    isOfflineRendering_ = nonRealtime;
 }
 
 
@@ -621,6 +811,12 @@ void KmeterAudioProcessor::processBlock(
     AudioBuffer<float> &buffer,
     MidiBuffer &midiMessages)
 {
+    FRUT_PROFILE_INSTANCE(this);
+    FRUT_PROFILE_SCOPE("KmeterAudioProcessor::processBlock");
+
+    // measure the complete callback, as seen by the host
+    int64 startTicks = Time::getHighResolutionTicks();
+
     ignoreUnused(midiMessages);
     jassert(!isUsingDoublePrecision());
 
@@ -710,68 +906,10 @@ void KmeterAudioProcessor::processBlock(
     // copy ring buffer back to buffer
     ringBuffer_->removeTo(buffer, 0, numberOfSamples);
 
-    float **bufferSample = buffer.getArrayOfWritePointers();
-
     // fade to mute / dim
-    for (int sample = 0; sample < numberOfSamples; ++sample)
-    {
-        // fade in
-        if (currentAttenuationDecibel_ < attenuationDecibel_)
-        {
-            currentAttenuationDecibel_ += outputFadeRate_;
-
-            if (currentAttenuationDecibel_ > attenuationDecibel_)
-            {
-                currentAttenuationDecibel_ = attenuationDecibel_;
-            }
-
-            if (currentAttenuationDecibel_ < 0.0)
-            {
-                outputGain_ = MeterBallistics::decibel2level_double(
-                                  currentAttenuationDecibel_);
-            }
-            else
-            {
-                outputGain_ = 1.0;
-            }
-        }
-        // fade out
-        else if (currentAttenuationDecibel_ > attenuationDecibel_)
-        {
-            currentAttenuationDecibel_ -= outputFadeRate_;
-
-            if (currentAttenuationDecibel_ < attenuationDecibel_)
-            {
-                currentAttenuationDecibel_ = attenuationDecibel_;
-            }
-
-            if (currentAttenuationDecibel_ > -60.0)
-            {
-                outputGain_ = MeterBallistics::decibel2level_double(
-                                  currentAttenuationDecibel_);
-            }
-            else
-            {
-                outputGain_ = 0.0;
-            }
-        }
-
-        if (outputGain_ != 1.0)
-        {
-            for (int channel = 0;
-                    channel < getMainBusNumInputChannels();
-                    ++channel)
-            {
-                // apply fade to sample
-                double fadedSample = outputGain_ * static_cast<double>(
-                                         bufferSample[channel][sample]);
+    fadeOutput(buffer);
 
-                // dither faded sample and store in buffer
-                bufferSample[channel][sample] = dither_.ditherSample(
-                                                    channel, fadedSample);
-            }
-        }
-    }
+    measureProcessingLoad(startTicks, numberOfSamples);
 }
 
 
@@ -779,11 +917,15 @@ void KmeterAudioProcessor::processBlock(
     AudioBuffer<double> &buffer,
     MidiBuffer &midiMessages)
 {
+    FRUT_PROFILE_INSTANCE(this);
+    FRUT_PROFILE_SCOPE("KmeterAudioProcessor::processBlock");
+
+    // measure the complete callback, as seen by the host
+    int64 startTicks = Time::getHighResolutionTicks();
+
     ignoreUnused(midiMessages);
     jassert(isUsingDoublePrecision());
 
-    DBG("[K-Meter] using double precision");
-
     // temporarily disable denormals
     ScopedNoDenormals noDenormals;
 
@@ -817,15 +959,17 @@ void KmeterAudioProcessor::processBlock(
     // reset meters if playback has started
     resetOnPlay();
 
+    // re-use temporary buffer (only re-allocates memory if the host
+    // exceeds the announced block size)
+    processBuffer_.setSize(numberOfChannels, numberOfSamples,
+                           false, false, true);
+
     // overwrite buffer with output of audio file player
     if (audioFilePlayer_)
     {
-        AudioBuffer<float> processBuffer(numberOfChannels, numberOfSamples);
-
         // copy output of audio file player and convert to double
-        audioFilePlayer_->copyTo(processBuffer);
-        dither_.convertToDouble(processBuffer, buffer);
-
+        audioFilePlayer_->copyTo(processBuffer_);
+        dither_.convertToDouble(processBuffer_, buffer);
     }
     // mute buffer if validation window is open
     else if (isSilent_)
@@ -866,28 +1010,25 @@ void KmeterAudioProcessor::processBlock(
         }
     }
 
-    // create temporary buffer
-    AudioBuffer<float> processBuffer(numberOfChannels, numberOfSamples);
-
     // dither input samples and store in temporary buffer
-    dither_.ditherToFloat(buffer, processBuffer);
+    dither_.ditherToFloat(buffer, processBuffer_);
 
     // copy temporary buffer to ring buffer (applies pre-delay)
     //
     // calls "processBufferChunk" each time chunkSize samples have
     // been added!
-    ringBuffer_->addFrom(processBuffer, 0, numberOfSamples);
+    ringBuffer_->addFrom(processBuffer_, 0, numberOfSamples);
 
     // to allow debugging of the average level filter, we'll have to
     // overwrite the input buffer from the ring buffer
     if (DEBUG_FILTER)
     {
         // copy ring buffer back to temporary buffer
-        ringBuffer_->removeTo(processBuffer, 0, numberOfSamples);
+        ringBuffer_->removeTo(processBuffer_, 0, numberOfSamples);
 
         // convert temporary buffer to double and store in output
         // buffer
-        dither_.convertToDouble(processBuffer, buffer);
+        dither_.convertToDouble(processBuffer_, buffer);
     }
     // otherwise, do not reduce the bit depth and stay in the double
     // domain
@@ -903,67 +1044,343 @@ void KmeterAudioProcessor::processBlock(
         ringBuffer_->removeToNull(numberOfSamples);
     }
 
-    double **bufferSample = buffer.getArrayOfWritePointers();
-
     // fade to mute / dim
-    for (int sample = 0; sample < numberOfSamples; ++sample)
+    fadeOutput(buffer);
+
+    measureProcessingLoad(startTicks, numberOfSamples);
+}
+
+
+/// Fade output to mute / dim.  The gain ramp is calculated once per
+/// block: as the fade is linear in decibels, every sample's gain
+/// differs from the previous one by a constant factor.  The gains are
+/// then applied channel by channel using vector operations.
+///
+/// @param buffer audio buffer to process
+///
+template <typename Type>
+void KmeterAudioProcessor::fadeOutput(
+    AudioBuffer<Type> &buffer)
+{
+    // no fade pending and unity gain, so there's nothing to do
+    if ((currentAttenuationDecibel_ == attenuationDecibel_) &&
+            (outputGain_ == 1.0))
+    {
+        return;
+    }
+
+    int numberOfChannels = getMainBusNumInputChannels();
+    int numberOfSamples = buffer.getNumSamples();
+    int sample = 0;
+
+    if (currentAttenuationDecibel_ != attenuationDecibel_)
     {
-        // fade in
-        if (currentAttenuationDecibel_ < attenuationDecibel_)
+        bool fadeIn = (currentAttenuationDecibel_ < attenuationDecibel_);
+        double fadeStep = fadeIn ? outputFadeRate_ : -outputFadeRate_;
+        double fadeFactor = fadeIn ? outputFadeFactor_ : 1.0 / outputFadeFactor_;
+
+        // the last sample of a fade is set to the target gain, so
+        // only ramp the samples before it
+        double fadeDistance = fabs(attenuationDecibel_ -
+                                   currentAttenuationDecibel_);
+        int samplesToTarget = static_cast<int>(
+                                  ceil(fadeDistance / outputFadeRate_));
+        int rampSamples = jmin(samplesToTarget - 1, numberOfSamples);
+
+        // gain of first sample in ramp
+        double gain = MeterBallistics::decibel2level_double(
+                          currentAttenuationDecibel_ + fadeStep);
+
+        // pre-calculate gains in short segments to keep them on the
+        // stack
+        const int segmentSize = 256;
+        Type gains[segmentSize];
+
+        while (sample < rampSamples)
         {
-            currentAttenuationDecibel_ += outputFadeRate_;
+            int samplesInSegment = jmin(segmentSize, rampSamples - sample);
 
-            if (currentAttenuationDecibel_ > attenuationDecibel_)
+            for (int n = 0; n < samplesInSegment; ++n)
             {
-                currentAttenuationDecibel_ = attenuationDecibel_;
+                gains[n] = static_cast<Type>(gain);
+                gain *= fadeFactor;
             }
 
-            if (currentAttenuationDecibel_ < 0.0)
+            for (int channel = 0; channel < numberOfChannels; ++channel)
             {
-                outputGain_ = MeterBallistics::decibel2level_double(
-                                  currentAttenuationDecibel_);
-            }
-            else
-            {
-                outputGain_ = 1.0;
+                FloatVectorOperations::multiply(
+                    buffer.getWritePointer(channel, sample),
+                    gains,
+                    samplesInSegment);
             }
+
+            sample += samplesInSegment;
         }
-        // fade out
-        else if (currentAttenuationDecibel_ > attenuationDecibel_)
+
+        if (rampSamples < numberOfSamples)
         {
-            currentAttenuationDecibel_ -= outputFadeRate_;
+            // fade has finished
+            currentAttenuationDecibel_ = attenuationDecibel_;
 
-            if (currentAttenuationDecibel_ < attenuationDecibel_)
+            if (currentAttenuationDecibel_ >= 0.0)
             {
-                currentAttenuationDecibel_ = attenuationDecibel_;
+                outputGain_ = 1.0;
             }
-
-            if (currentAttenuationDecibel_ > -60.0)
+            else if (currentAttenuationDecibel_ <= -60.0)
             {
-                outputGain_ = MeterBallistics::decibel2level_double(
-                                  currentAttenuationDecibel_);
+                outputGain_ = 0.0;
             }
             else
             {
-                outputGain_ = 0.0;
+                outputGain_ = MeterBallistics::decibel2level_double(
+                                  currentAttenuationDecibel_);
             }
         }
+        else
+        {
+            // fade continues in next block
+            currentAttenuationDecibel_ += fadeStep * rampSamples;
+
+            outputGain_ = MeterBallistics::decibel2level_double(
+                              currentAttenuationDecibel_);
+        }
+    }
+
+    // apply constant gain to remaining samples
+    int remainingSamples = numberOfSamples - sample;
+
+    if ((remainingSamples < 1) || (outputGain_ == 1.0))
+    {
+        return;
+    }
 
-        if (outputGain_ != 1.0)
+    for (int channel = 0; channel < numberOfChannels; ++channel)
+    {
+        if (outputGain_ == 0.0)
         {
-            for (int channel = 0;
-                    channel < getMainBusNumInputChannels();
-                    ++channel)
-            {
-                // apply fade to sample
-                double fadedSample = outputGain_ *
-                                     bufferSample[channel][sample];
+            buffer.clear(channel, sample, remainingSamples);
+        }
+        else
+        {
+            FloatVectorOperations::multiply(
+                buffer.getWritePointer(channel, sample),
+                static_cast<Type>(outputGain_),
+                remainingSamples);
+        }
+    }
+}
 
-                // store faded sample in buffer
-                bufferSample[channel][sample] = fadedSample;
-            }
+
+/// Determine levels of all channels and apply meter ballistics.
+///
+/// @tparam NumberOfChannels number of channels known at compile
+///         time, or zero to use the number of channels in the buffer
+///
+/// @param buffer buffer chunk to process
+///
+/// @param chunkSize number of samples in buffer chunk
+///
+/// @param isMono true if the stereo channels have been mixed down to
+///        mono
+///
+/// @param isDigitalSilence true if all samples in the buffer chunk
+///        are zero; peak levels must have been determined already
+///
+template <int NumberOfChannels>
+void KmeterAudioProcessor::processChannels(
+    const AudioBuffer<float> &buffer,
+    const int chunkSize,
+    const bool isMono,
+    const bool isDigitalSilence)
+{
+    const int numberOfChannels = (NumberOfChannels > 0) ?
+                                 NumberOfChannels : buffer.getNumChannels();
+    jassert(numberOfChannels == buffer.getNumChannels());
+    jassert(numberOfChannels <= peakLevels_.size());
+
+    float *peakLevels = peakLevels_.getRawDataPointer();
+    float *rmsLevels = rmsLevels_.getRawDataPointer();
+    float *averageLevelsFiltered = averageLevelsFiltered_.getRawDataPointer();
+    float *truePeakLevels = truePeakLevels_.getRawDataPointer();
+    int *overflowCounts = overflowCounts_.getRawDataPointer();
+
+    for (int channel = 0; channel < numberOfChannels; ++channel)
+    {
+        if (isMono && (channel == 1))
+        {
+            peakLevels[channel] = peakLevels[0];
+            rmsLevels[channel] = rmsLevels[0];
+            averageLevelsFiltered[channel] = averageLevelsFiltered[0];
+            truePeakLevels[channel] = truePeakLevels[0];
+
+            overflowCounts[channel] = overflowCounts[0];
+        }
+        else
+        {
+            // peak level for chunkSize samples has been determined
+            // by the caller
+
+            // determine RMS level for chunkSize samples
+            rmsLevels[channel] = isDigitalSilence ?
+                                 0.0f : buffer.getRMSLevel(channel, 0, chunkSize);
+
+            // determine filtered average level for chunkSize samples
+            // (please note that this level has already been converted
+            // to decibels!)
+            averageLevelsFiltered[channel] =
+                averageLevelFiltered_->getLevel(channel);
+
+            // determine true peak level for chunkSize samples
+            truePeakLevels[channel] = getTruePeakLevel(channel);
+
+            // determine overflows for chunkSize samples; treat all
+            // samples above -0.001 dBFS as overflow
+            //
+            // in the 16-bit domain, full scale corresponds to an
+            // absolute integer value of 32'767 or 32'768, so we'll
+            // treat absolute levels of 32'767 and above as overflows;
+            // this corresponds to a floating-point level of 32'767 /
+            // 32'768 = 0.9999694 (approx. -0.001 dBFS).
+            overflowCounts[channel] = isDigitalSilence ?
+                                      0 : countOverflows(buffer, channel, chunkSize, 0.9999f);
         }
     }
+
+    // apply meter ballistics to all channels at once and store values
+    // so that the editor can access them
+    meterBallistics_->updateChannels(processedSeconds_,
+                                     peakLevels,
+                                     truePeakLevels,
+                                     averageLevelsFiltered,
+                                     overflowCounts);
+}
+
+
+/// Report processing time of an audio buffer to the load monitor
+/// and the process-wide CPU governor.  Offline rendering has no
+/// deadline and is therefore not reported.
+///
+/// @param startTicks high-resolution ticks at the start of processing
+///
+/// @param numberOfSamples number of samples in the audio buffer
+///
+void KmeterAudioProcessor::measureProcessingLoad(
+    const int64 startTicks,
+    const int numberOfSamples)
+{
+    if (offlineTruePeakMeter_ != nullptr)
+    {
+        return;
+    }
+
+    double processingSeconds = Time::highResolutionTicksToSeconds(
+                                   Time::getHighResolutionTicks() - startTicks);
+    double bufferSeconds = numberOfSamples / getSampleRate();
+
+    loadMonitor_.addMeasurement(processingSeconds, bufferSeconds);
+    cpuGovernor_.addMeasurement(processingSeconds, bufferSeconds);
+}
+
+
+/// Get processing load of this instance for the period since this
+/// function was last called.  Must only be called from the GUI
+/// thread.
+///
+/// @return load statistics
+///
+frut::audio::LoadMonitor::Statistics KmeterAudioProcessor::getProcessingLoad()
+{
+    return loadMonitor_.getStatistics();
+}
+
+
+/// Get the fraction of the host's deadline above which a callback
+/// counts as a deadline miss.
+///
+/// @return fraction of the deadline
+///
+float KmeterAudioProcessor::getLoadMonitorDeadlineFraction() const
+{
+    return loadMonitor_.getDeadlineFraction();
+}
+
+
+/// Set the fraction of the host's deadline above which a callback
+/// counts as a deadline miss.
+///
+/// @param deadlineFraction fraction of the deadline (1.0 equals the
+///        full duration of an audio buffer)
+///
+void KmeterAudioProcessor::setLoadMonitorDeadlineFraction(
+    const float deadlineFraction)
+{
+    loadMonitor_.setDeadlineFraction(deadlineFraction);
+}
+
+
+/// Check whether meter readings have changed since this function was
+/// last called.  Must only be called from the editor.
+///
+/// @return true if the meters need to be updated
+///
+bool KmeterAudioProcessor::hasNewMeterReadings()
+{
+    return hasNewMeterReadings_.exchange(false);
+}
+
+
+/// Check whether any visible parameter has changed since this
+/// function was last called.  The changed parameters themselves are
+/// marked by their change flags.  Must only be called from the
+/// editor.
+///
+/// @return true if the editor needs to check for changed parameters
+///
+bool KmeterAudioProcessor::hasChangedParameters()
+{
+    return hasChangedParameters_.exchange(false);
+}
+
+
+/// Check whether the averaging algorithm has changed since this
+/// function was last called.  Must only be called from the editor.
+///
+/// @return true if the editor needs to update the algorithm buttons
+///
+bool KmeterAudioProcessor::hasChangedAverageAlgorithm()
+{
+    return hasChangedAverageAlgorithm_.exchange(false);
+}
+
+
+/// Check whether the CPU governor has stepped down optional
+/// processing stages (true peak oversampling, update rate of stereo
+/// meter and phase correlation).
+///
+/// @return true if processing has been degraded
+///
+bool KmeterAudioProcessor::isProcessingDegraded() const
+{
+    return isDegraded_.load();
+}
+
+
+/// Get true peak level of the last processed chunk from the meter
+/// that is currently in use.
+///
+/// @param channel audio channel
+///
+/// @return true peak level
+///
+float KmeterAudioProcessor::getTruePeakLevel(
+    const int channel)
+{
+    if (offlineTruePeakMeter_ != nullptr)
+    {
+        return offlineTruePeakMeter_->getLevel(channel);
+    }
+
+    return activeTruePeakMeter_->getLevel(channel);
 }
 
 
@@ -978,6 +1395,8 @@ void KmeterAudioProcessor::processBlock(
 bool KmeterAudioProcessor::processBufferChunk(
     AudioBuffer<float> &buffer)
 {
+    FRUT_PROFILE_SCOPE("KmeterAudioProcessor::processBufferChunk");
+
     int chunkSize = buffer.getNumSamples();
     bool isMono = getBoolean(KmeterPluginParameters::selMono);
 
@@ -986,72 +1405,185 @@ bool KmeterAudioProcessor::processBufferChunk(
     processedSeconds_ = static_cast<float>(chunkSize) /
                         static_cast<float>(getSampleRate());
 
-    // copy buffer to determine average level
-    averageLevelFiltered_->copyFrom(buffer, chunkSize);
+    // switch between real-time and offline true peak meters on
+    // chunk boundaries only
+    frut::dsp::TruePeakMeterParallel *offlineTruePeakMeter =
+        isOfflineRendering_.load() ? parallelTruePeakMeter_.get() : nullptr;
+
+    if (offlineTruePeakMeter != offlineTruePeakMeter_)
+    {
+        // neither meter has seen the audio of the other one
+        if (offlineTruePeakMeter != nullptr)
+        {
+            offlineTruePeakMeter->reset();
+        }
+        else
+        {
+            activeTruePeakMeter_->reset();
+        }
+
+        offlineTruePeakMeter_ = offlineTruePeakMeter;
+    }
+
+    // use exact decibel conversions during validation and offline
+    // rendering only
+    bool isOfflineAnalysis = (offlineTruePeakMeter_ != nullptr);
+    bool useExactConversion = (audioFilePlayer_ != nullptr) ||
+                              isOfflineAnalysis;
+
+    averageLevelFiltered_->setExactConversion(useExactConversion);
+    meterBallistics_->setExactConversion(useExactConversion);
+
+    // nobody is looking at the meters, so only keep track of what
+    // cannot be restored later on (overall maximum levels and
+    // overflows)
+    bool reduceWork = !isEditorOpen_.load() &&
+                      (audioFilePlayer_ == nullptr) &&
+                      !DEBUG_FILTER;
+
+    // editor has been opened, so restart the display-only parts
+    // from scratch
+    if (isReducingWork_ && !reduceWork)
+    {
+        averageLevelFiltered_->reset();
+        meterBallistics_->resetMeterLevels();
+    }
+
+    isReducingWork_ = reduceWork;
+
+    // the CPU governor only steps down optional stages during real-time
+    // processing; validation and offline rendering run at full quality
+    bool isDegraded = cpuGovernor_.isDegraded() &&
+                      (audioFilePlayer_ == nullptr) &&
+                      !isOfflineAnalysis;
+
+    if (isDegraded != isDegraded_)
+    {
+        frut::dsp::TruePeakMeter *truePeakMeter = truePeakMeter_.get();
+
+        // lower true peak oversampling (if possible)
+        if (isDegraded && (truePeakMeterReduced_ != nullptr))
+        {
+            truePeakMeter = truePeakMeterReduced_.get();
+        }
+
+        // start switched meter from scratch
+        if (truePeakMeter != activeTruePeakMeter_)
+        {
+            truePeakMeter->reset();
+            activeTruePeakMeter_ = truePeakMeter;
+        }
+
+        skipStereoUpdate_ = false;
+        isDegraded_ = isDegraded;
+    }
 
-    // copy buffer to determine true peak level
-    truePeakMeter_->copyFrom(buffer, chunkSize);
+    // determine peak levels for chunkSize samples; this also detects
+    // digital silence
+    float *peakLevels = peakLevels_.getRawDataPointer();
+    bool isDigitalSilence = true;
 
     for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
     {
-        if (isMono && (channel == 1))
+        peakLevels[channel] = buffer.getMagnitude(channel, 0, chunkSize);
+
+        if (peakLevels[channel] > 0.0f)
         {
-            peakLevels_.set(channel, peakLevels_[0]);
-            rmsLevels_.set(channel, rmsLevels_[0]);
-            averageLevelsFiltered_.set(channel, averageLevelsFiltered_[0]);
-            truePeakLevels_.set(channel, truePeakLevels_[0]);
+            isDigitalSilence = false;
+        }
+    }
 
-            overflowCounts_.set(channel, overflowCounts_[0]);
+    if (isDigitalSilence)
+    {
+        silentChunks_ = jmin(silentChunks_ + 1, silentChunksUntilBypass_ + 1);
+    }
+    else
+    {
+        silentChunks_ = 0;
+    }
+
+    if ((silentChunks_ < silentChunksUntilBypass_) && isOfflineAnalysis)
+    {
+        // determine true peak levels on worker threads (every
+        // channel has its own FFTW plans, so channels may be
+        // processed concurrently)
+        offlineTruePeakMeter_->startCopyFrom(buffer, chunkSize);
+
+        // meanwhile, determine average level on this thread
+        if (!reduceWork)
+        {
+            averageLevelFiltered_->copyFrom(buffer, chunkSize);
         }
-        else
+
+        offlineTruePeakMeter_->finishCopyFrom();
+    }
+    else if (silentChunks_ < silentChunksUntilBypass_)
+    {
+        // copy buffer to determine average level (display only)
+        if (!reduceWork)
         {
-            // determine peak level for chunkSize samples
-            peakLevels_.set(
-                channel,
-                buffer.getMagnitude(channel, 0, chunkSize));
+            averageLevelFiltered_->copyFrom(buffer, chunkSize);
+        }
 
-            // determine RMS level for chunkSize samples
-            rmsLevels_.set(
-                channel,
-                buffer.getRMSLevel(channel, 0, chunkSize));
+        // copy buffer to determine true peak level
+        activeTruePeakMeter_->copyFrom(buffer, chunkSize);
+    }
+    // the filter tails have decayed, so flush all filters; from now
+    // on, the results of both filters are known in advance (minimum
+    // level) and filtering can be skipped until the silence ends
+    else if (silentChunks_ == silentChunksUntilBypass_)
+    {
+        averageLevelFiltered_->reset();
+        activeTruePeakMeter_->reset();
 
-            // determine filtered average level for chunkSize samples
-            // (please note that this level has already been converted
-            // to decibels!)
-            averageLevelsFiltered_.set(
-                channel,
-                averageLevelFiltered_->getLevel(channel));
+        if (isOfflineAnalysis)
+        {
+            offlineTruePeakMeter_->reset();
+        }
+    }
 
-            // determine true peak level for chunkSize samples
-            truePeakLevels_.set(
-                channel,
-                truePeakMeter_->getLevel(channel));
+    if (reduceWork)
+    {
+        float *truePeakLevels = truePeakLevels_.getRawDataPointer();
+        int *overflowCounts = overflowCounts_.getRawDataPointer();
 
-            // determine overflows for chunkSize samples; treat all
-            // samples above -0.001 dBFS as overflow
-            //
-            // in the 16-bit domain, full scale corresponds to an
-            // absolute integer value of 32'767 or 32'768, so we'll
-            // treat absolute levels of 32'767 and above as overflows;
-            // this corresponds to a floating-point level of 32'767 /
-            // 32'768 = 0.9999694 (approx. -0.001 dBFS).
-            overflowCounts_.set(
-                channel,
-                countOverflows(buffer, channel, chunkSize, 0.9999f));
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            truePeakLevels[channel] = getTruePeakLevel(channel);
+            overflowCounts[channel] = isDigitalSilence ?
+                                      0 : countOverflows(buffer, channel, chunkSize, 0.9999f);
         }
 
-        // apply meter ballistics and store values so that the editor
-        // can access them
-        meterBallistics_->updateChannel(channel,
-                                        processedSeconds_,
-                                        peakLevels_[channel],
-                                        truePeakLevels_[channel],
-                                        averageLevelsFiltered_[channel],
-                                        overflowCounts_[channel]);
+        meterBallistics_->updateMaxima(peakLevels,
+                                       truePeakLevels,
+                                       overflowCounts);
+
+        // keep ring buffer contents
+        return false;
+    }
+
+    // use code that has been specialised for the channel count of
+    // the build target; fall back to generic code otherwise
+    if (buffer.getNumChannels() == KmeterPluginParameters::nNumChannels)
+    {
+        processChannels<KmeterPluginParameters::nNumChannels>(
+            buffer, chunkSize, isMono, isDigitalSilence);
+    }
+    else
+    {
+        processChannels<0>(buffer, chunkSize, isMono, isDigitalSilence);
     }
 
+    // when degraded, update stereo meter and phase correlation at
+    // half the rate only
+    bool updateStereo = !skipStereoUpdate_;
+    float stereoSeconds = isDegraded_ ?
+                          2.0f * processedSeconds_ : processedSeconds_;
+
+    skipStereoUpdate_ = isDegraded_ && !skipStereoUpdate_;
+
     // phase correlation is only defined for stereo signals
-    if (isStereo_)
+    if (isStereo_ && updateStereo)
     {
         float phaseCorrelation = 1.0f;
 
@@ -1094,7 +1626,7 @@ bool KmeterAudioProcessor::processBufferChunk(
             }
         }
 
-        meterBallistics_->setPhaseCorrelation(processedSeconds_,
+        meterBallistics_->setPhaseCorrelation(stereoSeconds,
                                               phaseCorrelation);
 
         float stereoMeterValue = 0.0f;
@@ -1113,12 +1645,13 @@ bool KmeterAudioProcessor::processBufferChunk(
             stereoMeterValue = rmsLevels_[1] / rmsLevels_[0] - 1.0f;
         }
 
-        meterBallistics_->setStereoMeterValue(processedSeconds_,
+        meterBallistics_->setStereoMeterValue(stereoSeconds,
                                               stereoMeterValue);
     }
 
-    // "UM" ==> update meters
-    sendActionMessage("UM");
+    // tell editor to update meters (never allocates, unlike
+    // action messages)
+    hasNewMeterReadings_.store(true);
 
     // To hear the audio source after average filtering, simply set
     // DEBUG_FILTER to "true".  Please remember to revert this
@@ -1371,16 +1904,39 @@ void KmeterAudioProcessor::setAverageAlgorithmFinal(
 
     //  the level averaging alghorithm has been changed, so update the
     // "RMS" and "ITU-R" buttons to make sure that the correct button
-    // is lit
-    //
-    // "AC" ==> algorithm changed
-    sendActionMessage("AC");
+    // is lit (the editor polls this flag)
+    hasChangedAverageAlgorithm_ = true;
 }
 
 
 AudioProcessorEditor *KmeterAudioProcessor::createEditor()
 {
-    return new KmeterAudioProcessorEditor(this, getMainBusNumInputChannels());
+    setEditorOpen(true);
+
+    return new KmeterAudioProcessorEditor(this, getChannelLayoutOfBus(true, 0));
+}
+
+
+void KmeterAudioProcessor::editorBeingDeleted(
+    AudioProcessorEditor *editor) noexcept
+{
+    setEditorOpen(false);
+
+    AudioProcessor::editorBeingDeleted(editor);
+}
+
+
+/// Tell the processor whether its meter readings are displayed.
+/// While they are not, display-only processing is skipped.  Called
+/// when the editor is created or deleted, but may also be used to
+/// process audio as if an editor were open.
+///
+/// @param isEditorOpen true if meter readings are displayed
+///
+void KmeterAudioProcessor::setEditorOpen(
+    const bool isEditorOpen) noexcept
+{
+    isEditorOpen_ = isEditorOpen;
 }
 
 
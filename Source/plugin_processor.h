@@ -49,6 +49,7 @@ public:
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     void reset() override;
+    void setNonRealtime(bool nonRealtime) noexcept override;
 
     void processBlock(AudioBuffer<float> &buffer,
                       MidiBuffer &midiMessages) override;
@@ -68,6 +69,8 @@ public:
 
     AudioProcessorEditor *createEditor() override;
     bool hasEditor() const override;
+    void editorBeingDeleted(AudioProcessorEditor *editor) noexcept override;
+    void setEditorOpen(const bool isEditorOpen) noexcept;
 
     int getNumParameters() override;
     const String getParameterName(int nIndex) override;
@@ -101,6 +104,14 @@ public:
     void setMeterInfiniteHold(bool infiniteHold);
     void resetMeters();
 
+    bool hasNewMeterReadings();
+    bool hasChangedParameters();
+    bool hasChangedAverageAlgorithm();
+    bool isProcessingDegraded() const;
+    frut::audio::LoadMonitor::Statistics getProcessingLoad();
+    float getLoadMonitorDeadlineFraction() const;
+    void setLoadMonitorDeadlineFraction(const float deadlineFraction);
+
     virtual bool processBufferChunk(AudioBuffer<float> &buffer) override;
 
     int getAverageAlgorithm();
@@ -125,6 +136,20 @@ private:
     static BusesProperties getBusesProperties();
     void resetOnPlay();
 
+    template <typename Type>
+    void fadeOutput(AudioBuffer<Type> &buffer);
+
+    template <int NumberOfChannels>
+    void processChannels(const AudioBuffer<float> &buffer,
+                         const int chunkSize,
+                         const bool isMono,
+                         const bool isDigitalSilence);
+
+    float getTruePeakLevel(const int channel);
+
+    void measureProcessingLoad(const int64 startTicks,
+                               const int numberOfSamples);
+
     int countOverflows(const AudioBuffer<float> &buffer,
                        const int channel,
                        const int numberOfSamples,
@@ -133,28 +158,68 @@ private:
     std::unique_ptr<AudioFilePlayer> audioFilePlayer_;
     std::unique_ptr<frut::audio::RingBuffer<float>> ringBuffer_;
     std::unique_ptr<frut::audio::RingBuffer<double>> ringBufferDouble_;
+    AudioBuffer<float> processBuffer_;
 
     std::unique_ptr<AverageLevelFiltered> averageLevelFiltered_;
     std::unique_ptr<frut::dsp::TruePeakMeter> truePeakMeter_;
+    std::unique_ptr<frut::dsp::TruePeakMeter> truePeakMeterReduced_;
+    frut::dsp::TruePeakMeter *activeTruePeakMeter_;
     std::shared_ptr<MeterBallistics> meterBallistics_;
 
+    // only used during offline rendering; "setNonRealtime" flags the
+    // switch, and the audio thread points "offlineTruePeakMeter_" to
+    // the prepared meter
+    std::unique_ptr<frut::dsp::TruePeakMeterParallel> parallelTruePeakMeter_;
+    frut::dsp::TruePeakMeterParallel *offlineTruePeakMeter_;
+    std::atomic<bool> isOfflineRendering_;
+
     KmeterPluginParameters pluginParameters_;
 
     const int kmeterBufferSize_;
 
+    // maximum under-read of true peak measurement is 0.169 dB (see
+    // Annex 2 of ITU-R BS.1770-4)
+    static const int maximumOversamplingFactor_ = 8;
+
     bool isStereo_;
     bool sampleRateIsValid_;
     bool isSilent_;
     bool hasStopped_;
 
+    int preparedNumberOfChannels_;
+    AudioChannelSet preparedChannelSet_;
+    double preparedSampleRate_;
+    int preparedOversamplingFactor_;
+
     int averageAlgorithmId_;
     float processedSeconds_;
 
+    int silentChunks_;
+    int silentChunksUntilBypass_;
+
+    // meters are only displayed while the editor is open
+    std::atomic<bool> isEditorOpen_;
+    std::atomic<bool> hasNewMeterReadings_;
+
+    // parameter changes are polled by the editor, so the audio
+    // thread never has to post messages
+    std::atomic<bool> hasChangedParameters_;
+    std::atomic<bool> hasChangedAverageAlgorithm_;
+    bool isReducingWork_;
+
+    // optional stages are stepped down when all instances together
+    // exceed their CPU budget
+    frut::audio::CpuGovernor cpuGovernor_;
+    frut::audio::LoadMonitor loadMonitor_;
+    std::atomic<bool> isDegraded_;
+    bool skipStereoUpdate_;
+
     double attenuationDecibel_;
     double currentAttenuationDecibel_;
 
     double outputGain_;
     double outputFadeRate_;
+    double outputFadeFactor_;
 
     Array<float> peakLevels_;
     Array<float> rmsLevels_;
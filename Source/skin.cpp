@@ -24,6 +24,7 @@
 ---------------------------------------------------------------------------- */
 
 #include "skin.h"
+#include "embedded_skin.h"
 
 
 bool Skin::loadSkin(File &skinFile,
@@ -40,8 +41,39 @@ bool Skin::loadSkin(File &skinFile,
                isExpanded,
                displayPeakMeter);
 
-    // signal success or failure
-    return loadFromXml(skinFile, "kmeter-skin", "1.4");
+    // prefer compiled skins as long as they are up to date (bundles
+    // are written by the skin compiler, never by the plug-in)
+    File bundleFile = skinFile.withFileExtension("skinbundle");
+
+    if (frut::skin::SkinBundle::isUpToDate(skinFile, bundleFile))
+    {
+        if (loadFromBundle(bundleFile, "kmeter-skin", "1.4"))
+        {
+            return true;
+        }
+    }
+
+    if (loadFromXml(skinFile, "kmeter-skin", "1.4"))
+    {
+        return true;
+    }
+
+#if KMETER_EMBEDDED_SKIN
+
+    // the skin directory may be missing altogether, so fall back to
+    // the default skin that has been compiled into the binary
+    Logger::outputDebugString("[Skin] falling back to embedded skin");
+
+    return loadFromBundle(KmeterEmbeddedSkin::bundleData,
+                          KmeterEmbeddedSkin::bundleSize,
+                          "kmeter-skin",
+                          "1.4");
+
+#else
+
+    return false;
+
+#endif  // KMETER_EMBEDDED_SKIN
 }
 
 
@@ -121,4 +153,6 @@ void Skin::updateSkin(int numberOfChannels,
         skinFallback_1_ = nullptr;
         skinFallback_2_ = nullptr;
     }
+
+    buildIndex();
 }
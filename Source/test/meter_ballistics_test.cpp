@@ -0,0 +1,90 @@
+/* ----------------------------------------------------------------------------
+
+   K-Meter
+   =======
+   Implementation of a K-System meter according to Bob Katz' specifications
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "../meter_ballistics.h"
+
+
+/// Compares the fast decibel conversion of MeterBallistics to the
+/// exact one over the full meter range.
+///
+class MeterBallisticsTest :
+    public UnitTest
+{
+public:
+    MeterBallisticsTest() :
+        UnitTest("Accuracy of fast decibel conversion")
+    {
+    }
+
+
+    void runTest() override
+    {
+        const double maximumError = 0.001;
+        const double meterMinimumDecibel = MeterBallistics::getMeterMinimumDecibel();
+
+        beginTest("level2decibel_fast from meter minimum to +20 dB");
+
+        double largestError = 0.0;
+        double decibelsAtLargestError = 0.0;
+
+        // use a step size that is not a "round" number to catch as
+        // many mantissas as possible
+        for (double decibels = meterMinimumDecibel;
+                decibels <= 20.0;
+                decibels += 0.0013)
+        {
+            float level = static_cast<float>(
+                              MeterBallistics::decibel2level_double(decibels));
+
+            double error = std::abs(
+                               MeterBallistics::level2decibel_fast(level) -
+                               MeterBallistics::level2decibel_double(level));
+
+            if (error > largestError)
+            {
+                largestError = error;
+                decibelsAtLargestError = decibels;
+            }
+        }
+
+        logMessage("maximum error is " + String(largestError, 6) +
+                   " dB at " + String(decibelsAtLargestError, 4) + " dB");
+
+        expectLessThan(largestError, maximumError);
+
+        beginTest("level2decibel_fast below meter minimum");
+
+        const float levels[] = {0.0f, 1e-30f, 1e-20f, 1e-8f};
+
+        for (float level : levels)
+        {
+            expectEquals(MeterBallistics::level2decibel_fast(level),
+                         static_cast<float>(meterMinimumDecibel));
+        }
+    }
+};
+
+
+static MeterBallisticsTest meterBallisticsTest;
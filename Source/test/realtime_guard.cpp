@@ -0,0 +1,304 @@
+/* ----------------------------------------------------------------------------
+
+   K-Meter
+   =======
+   Implementation of a K-System meter according to Bob Katz' specifications
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "realtime_guard.h"
+
+#if JUCE_LINUX
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <malloc.h>
+#include <pthread.h>
+
+
+// allocator of glibc (used by the interposed functions below)
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t numberOfElements, size_t size);
+    void *__libc_realloc(void *pointer, size_t size);
+    void *__libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void *pointer);
+}
+
+// the interposed functions must be exported even though release
+// builds hide all symbols by default
+#define KMETER_TEST_INTERPOSE extern "C" __attribute__((visibility("default")))
+
+typedef int (*MutexLockFunction)(pthread_mutex_t *mutex);
+
+static const int maximumNumberOfFrames = 64;
+
+// only threads that have called "startChecking" are checked
+static thread_local bool isChecking = false;
+
+static std::atomic<int> numberOfViolations(0);
+static std::atomic<MutexLockFunction> realMutexLock(nullptr);
+
+// first violation; stored without allocating
+static const char *violationName = nullptr;
+static void *violationFrames[maximumNumberOfFrames];
+static int numberOfViolationFrames = 0;
+
+
+static void recordViolation(
+    const char *name)
+{
+    // "backtrace" must not be checked
+    isChecking = false;
+
+    if (numberOfViolations++ == 0)
+    {
+        violationName = name;
+        numberOfViolationFrames = backtrace(violationFrames,
+                                            maximumNumberOfFrames);
+    }
+
+    isChecking = true;
+}
+
+
+KMETER_TEST_INTERPOSE void *malloc(size_t size) noexcept
+{
+    if (isChecking)
+    {
+        recordViolation("malloc");
+    }
+
+    return __libc_malloc(size);
+}
+
+
+KMETER_TEST_INTERPOSE void *calloc(size_t numberOfElements, size_t size) noexcept
+{
+    if (isChecking)
+    {
+        recordViolation("calloc");
+    }
+
+    return __libc_calloc(numberOfElements, size);
+}
+
+
+KMETER_TEST_INTERPOSE void *realloc(void *pointer, size_t size) noexcept
+{
+    if (isChecking)
+    {
+        recordViolation("realloc");
+    }
+
+    return __libc_realloc(pointer, size);
+}
+
+
+KMETER_TEST_INTERPOSE void *memalign(size_t alignment, size_t size) noexcept
+{
+    if (isChecking)
+    {
+        recordViolation("memalign");
+    }
+
+    return __libc_memalign(alignment, size);
+}
+
+
+KMETER_TEST_INTERPOSE void *aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    if (isChecking)
+    {
+        recordViolation("aligned_alloc");
+    }
+
+    return __libc_memalign(alignment, size);
+}
+
+
+KMETER_TEST_INTERPOSE int posix_memalign(void **pointer, size_t alignment, size_t size) noexcept
+{
+    if (isChecking)
+    {
+        recordViolation("posix_memalign");
+    }
+
+    void *memory = __libc_memalign(alignment, size);
+
+    if (memory == nullptr)
+    {
+        return ENOMEM;
+    }
+
+    *pointer = memory;
+    return 0;
+}
+
+
+KMETER_TEST_INTERPOSE void free(void *pointer) noexcept
+{
+    // freeing a null pointer is a no-op
+    if (isChecking && (pointer != nullptr))
+    {
+        recordViolation("free");
+    }
+
+    __libc_free(pointer);
+}
+
+
+KMETER_TEST_INTERPOSE int pthread_mutex_lock(pthread_mutex_t *mutex) noexcept
+{
+    MutexLockFunction mutexLock = realMutexLock.load(std::memory_order_relaxed);
+
+    if (mutexLock == nullptr)
+    {
+        mutexLock = reinterpret_cast<MutexLockFunction>(
+                        dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        realMutexLock.store(mutexLock, std::memory_order_relaxed);
+    }
+
+    if (isChecking)
+    {
+        recordViolation("pthread_mutex_lock");
+    }
+
+    return mutexLock(mutex);
+}
+
+
+bool RealtimeGuard::isSupported()
+{
+    return true;
+}
+
+
+/// Start trapping allocations and locks on the calling thread.
+///
+void RealtimeGuard::startChecking()
+{
+    // the first call of "backtrace" loads libgcc and thus
+    // allocates, so make sure this does not happen while checking
+    static bool hasWarmedUp = false;
+
+    if (!hasWarmedUp)
+    {
+        void *frames[maximumNumberOfFrames];
+        backtrace(frames, maximumNumberOfFrames);
+
+        hasWarmedUp = true;
+    }
+
+    isChecking = true;
+}
+
+
+/// Stop trapping allocations and locks on the calling thread.
+///
+void RealtimeGuard::stopChecking()
+{
+    isChecking = false;
+}
+
+#else
+
+bool RealtimeGuard::isSupported()
+{
+    return false;
+}
+
+
+void RealtimeGuard::startChecking()
+{
+}
+
+
+void RealtimeGuard::stopChecking()
+{
+}
+
+#endif  // JUCE_LINUX
+
+
+/// Get number of allocations and locks that have been trapped since
+/// the violations were last cleared.
+///
+/// @return number of violations
+///
+int RealtimeGuard::getNumberOfViolations()
+{
+#if JUCE_LINUX
+    return numberOfViolations.load();
+#else
+    return 0;
+#endif
+}
+
+
+/// Describe the first trapped violation, including a backtrace.
+/// Must not be called while checking.
+///
+/// @return description of first violation (empty if there was none)
+///
+String RealtimeGuard::getFirstViolation()
+{
+#if JUCE_LINUX
+
+    if (numberOfViolations.load() == 0)
+    {
+        return String();
+    }
+
+    String description = String(violationName) + " called from\n";
+    char **symbols = backtrace_symbols(violationFrames, numberOfViolationFrames);
+
+    if (symbols != nullptr)
+    {
+        // skip "recordViolation" and the interposed function
+        for (int frame = 2; frame < numberOfViolationFrames; ++frame)
+        {
+            description += "    " + String(symbols[frame]) + "\n";
+        }
+
+        ::free(symbols);
+    }
+
+    return description;
+
+#else
+
+    return String();
+
+#endif
+}
+
+
+/// Forget all trapped violations.
+///
+void RealtimeGuard::clearViolations()
+{
+#if JUCE_LINUX
+    numberOfViolations = 0;
+    violationName = nullptr;
+    numberOfViolationFrames = 0;
+#endif
+}
@@ -0,0 +1,53 @@
+/* ----------------------------------------------------------------------------
+
+   K-Meter
+   =======
+   Implementation of a K-System meter according to Bob Katz' specifications
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#ifndef KMETER_TEST_REALTIME_GUARD_H
+#define KMETER_TEST_REALTIME_GUARD_H
+
+#include "FrutHeader.h"
+
+
+/// Traps memory allocations and mutex locks on threads that are
+/// marked as real-time.  On Linux, "malloc", "free" and friends as
+/// well as "pthread_mutex_lock" are interposed by the test
+/// executable; other platforms are not supported.
+///
+class RealtimeGuard
+{
+public:
+    static bool isSupported();
+
+    static void startChecking();
+    static void stopChecking();
+
+    static int getNumberOfViolations();
+    static String getFirstViolation();
+    static void clearViolations();
+
+private:
+    JUCE_DECLARE_NON_COPYABLE(RealtimeGuard);
+};
+
+#endif  // KMETER_TEST_REALTIME_GUARD_H
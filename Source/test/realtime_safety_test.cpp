@@ -0,0 +1,197 @@
+/* ----------------------------------------------------------------------------
+
+   K-Meter
+   =======
+   Implementation of a K-System meter according to Bob Katz' specifications
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "realtime_guard.h"
+#include "../plugin_processor.h"
+
+
+/// Runs "processBlock" like a host would and fails on any memory
+/// allocation or mutex lock on the audio thread.  The test covers
+/// all supported channel layouts, single and double precision,
+/// several sample rates and block sizes, parameter changes from the
+/// audio thread and both open and closed editors.
+///
+class RealtimeSafetyTest :
+    public UnitTest
+{
+public:
+    RealtimeSafetyTest() :
+        UnitTest("Real-time safety of processBlock")
+    {
+    }
+
+
+    void runTest() override
+    {
+        if (!RealtimeGuard::isSupported())
+        {
+            beginTest("skipped");
+            logMessage("trapping allocations and locks is only supported on Linux");
+
+            return;
+        }
+
+        Array<AudioChannelSet> channelSets;
+        channelSets.add(AudioChannelSet::stereo());
+        channelSets.add(AudioChannelSet::create5point1());
+        channelSets.add(AudioChannelSet::create7point1());
+        channelSets.add(AudioChannelSet::ambisonic(3));
+
+        for (const auto &channelSet : channelSets)
+        {
+            for (int precision = 0; precision < 2; ++precision)
+            {
+                testChannelSet(channelSet, precision == 1);
+            }
+        }
+    }
+
+private:
+    void testChannelSet(const AudioChannelSet &channelSet,
+                        const bool useDoublePrecision)
+    {
+        const double sampleRates[] = {44100.0, 48000.0, 96000.0, 192000.0};
+        const int blockSizes[] = {1, 32, 64, 100, 512, 1024, 1536, 4096};
+
+        KmeterAudioProcessor processor;
+
+        AudioProcessor::BusesLayout busesLayout;
+        busesLayout.inputBuses.add(channelSet);
+        busesLayout.outputBuses.add(channelSet);
+
+        // channel layouts depend on the build variant
+        if (!processor.setBusesLayout(busesLayout))
+        {
+            return;
+        }
+
+        processor.setProcessingPrecision(useDoublePrecision ?
+                                         AudioProcessor::doublePrecision :
+                                         AudioProcessor::singlePrecision);
+
+        for (double sampleRate : sampleRates)
+        {
+            for (int blockSize : blockSizes)
+            {
+                beginTest(channelSet.getDescription() + ", " +
+                          (useDoublePrecision ? "double, " : "float, ") +
+                          String(sampleRate, 0) + " Hz, " +
+                          String(blockSize) + " samples");
+
+                processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+                processor.prepareToPlay(sampleRate, blockSize);
+
+                if (useDoublePrecision)
+                {
+                    runBlocks<double>(processor, channelSet.size(), blockSize);
+                }
+                else
+                {
+                    runBlocks<float>(processor, channelSet.size(), blockSize);
+                }
+            }
+        }
+
+        processor.releaseResources();
+    }
+
+
+    template <typename Type>
+    void runBlocks(KmeterAudioProcessor &processor,
+                   const int numberOfChannels,
+                   const int blockSize)
+    {
+        // half a second of audio, but at least a few chunks
+        int numberOfSamples = jmax(roundToInt(processor.getSampleRate() / 2.0),
+                                   8 * 1024);
+        int numberOfBlocks = (numberOfSamples + blockSize - 1) / blockSize;
+
+        // change a parameter roughly every 10 ms
+        int blocksPerParameterChange = jmax(1, roundToInt(
+                                                0.01 * processor.getSampleRate() / blockSize));
+
+        AudioBuffer<Type> buffer(numberOfChannels, blockSize);
+        MidiBuffer midiMessages;
+
+        // use fixed seed so that all runs process identical data
+        Random random(42);
+
+        int numberOfParameters = processor.getNumParameters();
+        int parameterChanges = 0;
+
+        // start with a closed editor (also closes the editor of the
+        // previous run)
+        processor.setEditorOpen(false);
+
+        RealtimeGuard::clearViolations();
+
+        for (int block = 0; block < numberOfBlocks; ++block)
+        {
+            for (int channel = 0; channel < numberOfChannels; ++channel)
+            {
+                Type *samples = buffer.getWritePointer(channel);
+
+                for (int sample = 0; sample < blockSize; ++sample)
+                {
+                    samples[sample] = static_cast<Type>(random.nextFloat() - 0.5f);
+                }
+            }
+
+            RealtimeGuard::startChecking();
+
+            // hosts may automate parameters on the audio thread; the
+            // values alternate between both ends of the range
+            if ((block % blocksPerParameterChange) == 0)
+            {
+                int nIndex = parameterChanges % numberOfParameters;
+                float fValue = ((parameterChanges / numberOfParameters) % 2 == 0) ?
+                               1.0f : 0.0f;
+
+                processor.setParameter(nIndex, fValue);
+                ++parameterChanges;
+            }
+
+            processor.processBlock(buffer, midiMessages);
+
+            RealtimeGuard::stopChecking();
+
+            // meters are only updated while the editor is open, so
+            // test both
+            if (block == numberOfBlocks / 2)
+            {
+                processor.setEditorOpen(true);
+            }
+        }
+
+        int numberOfViolations = RealtimeGuard::getNumberOfViolations();
+
+        expect(numberOfViolations == 0,
+               String(numberOfViolations) + " allocation(s) or lock(s) on the audio thread; first one was " +
+               RealtimeGuard::getFirstViolation());
+    }
+};
+
+
+static RealtimeSafetyTest realtimeSafetyTest;
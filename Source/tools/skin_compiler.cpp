@@ -0,0 +1,212 @@
+/* ----------------------------------------------------------------------------
+
+   K-Meter
+   =======
+   Implementation of a K-System meter according to Bob Katz' specifications
+
+   Copyright (c) 2010-2020 Martin Zuther (http://www.mzuther.de/)
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+   Thank you for using free software!
+
+---------------------------------------------------------------------------- */
+
+#include "FrutHeader.h"
+
+#include <iostream>
+
+
+// Compiles skins into bundles (see frut::skin::SkinBundle), either
+// next to their XML documents or into C++ code that is built into
+// the plug-in as its default skin.
+
+
+static void print(const String &line)
+{
+    std::cout << line << std::endl;
+}
+
+
+static void printUsage(const String &applicationName)
+{
+    print("Usage: " + applicationName + " [--force] SKIN_FILE ...");
+    print("       " + applicationName + " --embed SKIN_FILE OUTPUT_FILE");
+    print("");
+    print("  Compile skins into bundles next to their XML documents.  Bundles");
+    print("  that are up to date are skipped unless \"--force\" is given.");
+    print("");
+    print("  \"--embed\" compiles a skin into C++ code instead; only images");
+    print("  are included.  The default skin is built into the plug-in from");
+    print("  \"Source/generated/default_skin.cpp\", so update that file after");
+    print("  changing the default skin.");
+}
+
+
+static bool compileSkin(const File &skinFile,
+                        const bool force)
+{
+    File bundleFile = skinFile.withFileExtension("skinbundle");
+
+    if (!force && frut::skin::SkinBundle::isUpToDate(skinFile, bundleFile))
+    {
+        print("up to date: " + bundleFile.getFullPathName());
+        return true;
+    }
+
+    if (!frut::skin::SkinBundle::writeBundle(skinFile, bundleFile))
+    {
+        print("failed:     " + skinFile.getFullPathName());
+        return false;
+    }
+
+    print("compiled:   " + bundleFile.getFullPathName());
+    return true;
+}
+
+
+static bool embedSkin(const File &skinFile,
+                      const File &outputFile)
+{
+    TemporaryFile bundleFile(skinFile.withFileExtension("skinbundle"));
+
+    // the plug-in only loads images, so leave out everything else
+    // (such as the skin's source artwork)
+    if (!frut::skin::SkinBundle::writeBundle(skinFile, bundleFile.getFile(),
+                                              "*.png"))
+    {
+        print("failed:     " + skinFile.getFullPathName());
+        return false;
+    }
+
+    MemoryBlock bundleData;
+
+    if (!bundleFile.getFile().loadFileAsData(bundleData))
+    {
+        print("failed:     " + skinFile.getFullPathName());
+        return false;
+    }
+
+    MemoryOutputStream code;
+
+    code << "// compiled from \"" << skinFile.getFileName()
+         << "\" by the skin compiler -- do not edit!\n"
+         << "\n"
+         << "#include \"../embedded_skin.h\"\n"
+         << "\n"
+         << "\n"
+         << "namespace KmeterEmbeddedSkin\n"
+         << "{\n"
+         << "\n"
+         << "const unsigned char bundleData[] =\n"
+         << "{\n";
+
+    const uint8 *bytes = static_cast<const uint8 *>(bundleData.getData());
+    size_t numberOfBytes = bundleData.getSize();
+
+    for (size_t index = 0; index < numberOfBytes; ++index)
+    {
+        if ((index % 16) == 0)
+        {
+            code << "   ";
+        }
+
+        code << " " << String(static_cast<int>(bytes[index])) << ",";
+
+        if (((index % 16) == 15) || (index == numberOfBytes - 1))
+        {
+            code << "\n";
+        }
+    }
+
+    code << "};\n"
+         << "\n"
+         << "const size_t bundleSize = " << String(static_cast<int64>(numberOfBytes))
+         << ";\n"
+         << "\n"
+         << "}\n";
+
+    // leave unchanged files alone to prevent needless re-builds
+    if (outputFile.existsAsFile() &&
+            (outputFile.loadFileAsString() == code.toString()))
+    {
+        print("up to date: " + outputFile.getFullPathName());
+        return true;
+    }
+
+    outputFile.getParentDirectory().createDirectory();
+
+    if (!outputFile.replaceWithText(code.toString()))
+    {
+        print("failed:     " + outputFile.getFullPathName());
+        return false;
+    }
+
+    print("embedded:   " + outputFile.getFullPathName());
+    return true;
+}
+
+
+int main(int argc, char *argv[])
+{
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    String applicationName = File::getSpecialLocation(
+                                 File::currentExecutableFile).getFileName();
+    StringArray arguments;
+
+    for (int argument = 1; argument < argc; ++argument)
+    {
+        arguments.add(argv[argument]);
+    }
+
+    File currentDirectory = File::getCurrentWorkingDirectory();
+
+    if (arguments[0] == "--embed")
+    {
+        if (arguments.size() != 3)
+        {
+            printUsage(applicationName);
+            return 1;
+        }
+
+        File skinFile = currentDirectory.getChildFile(arguments[1]);
+        File outputFile = currentDirectory.getChildFile(arguments[2]);
+
+        return embedSkin(skinFile, outputFile) ? 0 : 1;
+    }
+
+    bool force = arguments.contains("--force");
+    arguments.removeString("--force");
+
+    if (arguments.isEmpty())
+    {
+        printUsage(applicationName);
+        return 1;
+    }
+
+    bool success = true;
+
+    for (const auto &argument : arguments)
+    {
+        File skinFile = currentDirectory.getChildFile(argument);
+
+        if (!compileSkin(skinFile, force))
+        {
+            success = false;
+        }
+    }
+
+    return success ? 0 : 1;
+}